@@ -0,0 +1,194 @@
+/**
+ * @name adjacency.h
+ * @brief provides shared, immutable connection table for each board size.
+ */
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+
+#include <vector>
+#include <assert.h>
+#include <stdint.h>
+
+#include "node.h"
+#include "bitboard.h"
+
+/// @brief class : Edge enumeration : board borders, GREEN joins LEFT/RIGHT, RED joins TOP/BOTTOM
+enum class Edge : uint8_t { TOP, BOTTOM, LEFT, RIGHT };
+
+static const uint8_t cn_MAX_CONNECTIONS = 6; // hex cell has at most six neighbours
+static const uint8_t cn_MAX_BRIDGES     = 6; // hex cell has at most six bridge partners
+
+/**
+ * @brief Bridge : cell two steps away joined through two shared free neighbours.
+ * @details a stone and its partner are virtually connected while both
+ * carrier cells are free: an intrusion into one is answered in the other.
+ */
+struct Bridge {
+    CellId partner;
+    CellId carriers[2];
+};
+
+/**
+ * @brief class Adjacency : connection table for a board size, indexed by cell id.
+ * @tparam N - board size
+ *
+ * @details constructed at compile time, one constant instance per board size
+ * (see get()), so every Graph of that size refers to the same table and
+ * copies made during play outs carry no connection data at all.
+ *
+ * @note Connection Algorithm:
+ *     A node is connected if its dRow or dColumn value == 1, i.e. node 0,3 is not connected to 2,1,
+ *     because the dRow == 2 and dColumn == 2, however node 0,3 is connected to 1, 0, because
+ *     dRow == 1.
+ *
+ *     if ((dR == -1 && dC == -1)) || ((dR == 1) && (dC == 1))
+ *         not connected.
+ *     else if (dR == 1 && dC == 0) || (dC == 0 and dC == 1)
+ *         connected.
+ *     else
+ *         not connected (default).
+ */
+template <MapSize N>
+class Adjacency {
+public:
+    static constexpr CellId cn_STRIDE       = N + 1;            // row stride including guard column
+    static constexpr CellId cn_CELL_COUNT   = N * cn_STRIDE;    // cell ids (including guard cells)
+    static constexpr CellId cn_NODE_COUNT   = cn_CELL_COUNT + 4; // cell ids plus virtual edge nodes
+
+    /// @brief get : returns constant table for board size.
+    /// @return const Adjacency&
+    static const Adjacency& get() { return cn_TABLE; }
+
+    /// @brief getCellId : returns linear bitboard index for coordinates.
+    /// @param row, col
+    /// @return CellId
+    static constexpr CellId getCellId(const Coordinate& row, const Coordinate& col) {
+        return static_cast<CellId>((row * cn_STRIDE) + col);
+    }
+
+    /// @brief getPosition : returns coordinates for linear bitboard index.
+    /// @param id
+    /// @return Position
+    static Position getPosition(const CellId& id) {
+        return Position(static_cast<Coordinate>(id / cn_STRIDE), static_cast<Coordinate>(id % cn_STRIDE));
+    }
+
+    /// @brief getRotated : returns cell id under 180 degree rotation of the board.
+    /// @details (row, col) -> (N - 1 - row, N - 1 - col), each player's edges
+    /// map onto each other so the rotated position is equivalent.
+    /// @param id - valid cell id
+    /// @return CellId
+    static constexpr CellId getRotated(const CellId& id) {
+        return static_cast<CellId>(getCellId(N - 1, N - 1) - id);
+    }
+
+    /// @brief getEdgeId : returns id of virtual node for edge, placed after all cell ids.
+    /// @details used by DisjointSet to join border stones to their edge.
+    /// @param edge
+    /// @return CellId
+    static constexpr CellId getEdgeId(const Edge& edge) {
+        return static_cast<CellId>(cn_CELL_COUNT + static_cast<uint8_t>(edge));
+    }
+
+    /// @brief getNeighbours : returns pointer to first neighbour id of cell
+    /// @details use with getNeighbourCount() for iteration.
+    /// @param id
+    /// @return const CellId*
+    constexpr const CellId * getNeighbours(const CellId& id) const { return m_neighbours[id]; }
+
+    /// @brief getNeighbourCount : returns number of neighbours of cell
+    constexpr uint8_t getNeighbourCount(const CellId& id) const { return m_neighbour_count[id]; }
+
+    /// @brief getBridges : returns pointer to first bridge of cell
+    /// @details use with getBridgeCount() for iteration.
+    constexpr const Bridge * getBridges(const CellId& id) const { return m_bridges[id]; }
+
+    /// @brief getBridgeCount : returns number of bridge partners of cell
+    constexpr uint8_t getBridgeCount(const CellId& id) const { return m_bridge_count[id]; }
+
+    /// @brief getCells : returns mask of valid cells
+    constexpr const Bitboard<N>& getCells() const { return m_cells; }
+
+    /// @brief getBorder : returns mask of cells along edge
+    constexpr const Bitboard<N>& getBorder(const Edge& edge) const { return m_borders[static_cast<uint8_t>(edge)]; }
+
+    /// @brief Adjacency : constexpr constructor, generates table from board size.
+    constexpr Adjacency() :
+        m_neighbours{},
+        m_neighbour_count{},
+        m_bridges{},
+        m_bridge_count{},
+        m_cells(),
+        m_borders() {
+
+        // dRow, dCol pairs satisfying the connection algorithm
+        const int offsets[cn_MAX_CONNECTIONS][2] = {
+            { -1, 0 }, { -1, 1 }, { 0, -1 }, { 0, 1 }, { 1, -1 }, { 1, 0 }
+        };
+
+        // bridge dRow, dCol, then the two neighbour offsets (above) it is the sum of
+        const int bridges[cn_MAX_BRIDGES][4] = {
+            { -2, 1, 0, 1 }, { -1, 2, 1, 3 }, { 1, 1, 3, 5 },
+            { 2, -1, 4, 5 }, { 1, -2, 2, 4 }, { -1, -1, 0, 2 }
+        };
+
+        for (Coordinate row_idx = 0; row_idx < N; ++row_idx) {
+
+            for (Coordinate col_idx = 0; col_idx < N; ++col_idx) {
+                CellId id = getCellId(row_idx, col_idx);
+                m_cells.set(id);
+
+                if (row_idx == 0)       m_borders[static_cast<uint8_t>(Edge::TOP)].set(id);
+                if (row_idx == (N - 1)) m_borders[static_cast<uint8_t>(Edge::BOTTOM)].set(id);
+                if (col_idx == 0)       m_borders[static_cast<uint8_t>(Edge::LEFT)].set(id);
+                if (col_idx == (N - 1)) m_borders[static_cast<uint8_t>(Edge::RIGHT)].set(id);
+
+                for (uint8_t idx = 0; idx < cn_MAX_CONNECTIONS; ++idx) {
+                    int row = row_idx + offsets[idx][0];
+                    int col = col_idx + offsets[idx][1];
+
+                    if ((row >= 0) && (row < N) && (col >= 0) && (col < N)) {
+                        m_neighbours[id][m_neighbour_count[id]++] =
+                                getCellId(static_cast<Coordinate>(row), static_cast<Coordinate>(col));
+                    }
+                }
+
+                for (uint8_t idx = 0; idx < cn_MAX_BRIDGES; ++idx) {
+                    int row = row_idx + bridges[idx][0];
+                    int col = col_idx + bridges[idx][1];
+
+                    // carriers lie between the two cells, on the board whenever the partner is
+                    if ((row >= 0) && (row < N) && (col >= 0) && (col < N)) {
+                        Bridge& bridge = m_bridges[id][m_bridge_count[id]++];
+                        bridge.partner = getCellId(static_cast<Coordinate>(row), static_cast<Coordinate>(col));
+
+                        for (uint8_t carrier = 0; carrier < 2; ++carrier) {
+                            const int* offset = offsets[bridges[idx][2 + carrier]];
+                            bridge.carriers[carrier] = getCellId(static_cast<Coordinate>(row_idx + offset[0]),
+                                                                 static_cast<Coordinate>(col_idx + offset[1]));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    ~Adjacency() = default;
+private:
+    static const Adjacency cn_TABLE;
+
+    CellId      m_neighbours[cn_CELL_COUNT][cn_MAX_CONNECTIONS];  // indexed by cell id (guard cells empty)
+    uint8_t     m_neighbour_count[cn_CELL_COUNT];
+    Bridge      m_bridges[cn_CELL_COUNT][cn_MAX_BRIDGES];         // indexed by cell id (guard cells empty)
+    uint8_t     m_bridge_count[cn_CELL_COUNT];
+    Bitboard<N> m_cells;
+    Bitboard<N> m_borders[4];
+};
+
+template <MapSize N>
+constexpr Adjacency<N> Adjacency<N>::cn_TABLE{};
+
+#endif
+    // ADJACENCY_H
+
+/****************************************end of file****************************************/
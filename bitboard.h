@@ -0,0 +1,135 @@
+/**
+ * @name bitboard.h
+ * @brief provides bit per cell board representation for hex game.
+ */
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/// @brief aliases for bitboard storage.
+using BitboardWord = uint64_t;
+using CellId = uint16_t; // linear cell index (row * stride + col)
+using MapSize = uint8_t;
+
+static const size_t cn_BITBOARD_WORD_BITS = 64;
+
+/**
+ * @brief class Bitboard : fixed width bit set, one bit per board cell.
+ * @tparam N - board size, storage is exactly the words needed for N * (N + 1) bits.
+ *
+ * @details cells are stored row major with a stride of (size + 1), the extra
+ * column on the end of each row is a guard column which is never set. This
+ * allows neighbour sets to be generated through shifts without wrapping from
+ * one row onto the next:
+ *
+ *     neighbours(id) = id - stride, id - stride + 1, id - 1,
+ *                      id + 1, id + stride - 1, id + stride
+ *
+ * Shifting col 0 left or col (size - 1) right always lands on a guard bit,
+ * which is removed by masking with the valid cell set.
+ *
+ * @note word count is a compile time constant so every loop below is
+ * unrolled by the compiler.
+ */
+template <MapSize N>
+class Bitboard {
+public:
+    static constexpr size_t cn_WORDS = ((N * (N + 1)) + (cn_BITBOARD_WORD_BITS - 1)) / cn_BITBOARD_WORD_BITS;
+
+    constexpr Bitboard() : m_words{} { }
+
+    /// @brief test : returns true if bit is set
+    /// @param bit
+    /// @return true / false
+    constexpr bool test(const CellId& bit) const {
+        return ((m_words[bit / cn_BITBOARD_WORD_BITS] >> (bit % cn_BITBOARD_WORD_BITS)) & 1u) != 0;
+    }
+
+    /// @brief set : sets bit
+    /// @param bit
+    constexpr void set(const CellId& bit) {
+        m_words[bit / cn_BITBOARD_WORD_BITS] |= (BitboardWord(1) << (bit % cn_BITBOARD_WORD_BITS));
+    }
+
+    /// @brief reset : clears bit
+    /// @param bit
+    constexpr void reset(const CellId& bit) {
+        m_words[bit / cn_BITBOARD_WORD_BITS] &= ~(BitboardWord(1) << (bit % cn_BITBOARD_WORD_BITS));
+    }
+
+    /// @brief any : returns true if any bit is set
+    /// @return true / false
+    constexpr bool any() const {
+        BitboardWord acc = 0;
+        for (size_t idx = 0; idx < cn_WORDS; ++idx)
+            acc |= m_words[idx];
+        return (acc != 0);
+    }
+
+    /// @brief none : returns true if no bits are set
+    /// @return true / false
+    constexpr bool none() const { return !any(); }
+
+    /// @brief shiftUp : shifts all bits towards higher cell ids
+    /// @param count - number of bits (1 to word size - 1)
+    /// @return Bitboard
+    constexpr Bitboard shiftUp(const size_t& count) const {
+        Bitboard ret;
+        ret.m_words[0] = (m_words[0] << count);
+        for (size_t idx = 1; idx < cn_WORDS; ++idx) {
+            ret.m_words[idx] = (m_words[idx] << count) |
+                    (m_words[idx - 1] >> (cn_BITBOARD_WORD_BITS - count));
+        }
+        return ret;
+    }
+
+    /// @brief shiftDown : shifts all bits towards lower cell ids
+    /// @param count - number of bits (1 to word size - 1)
+    /// @return Bitboard
+    constexpr Bitboard shiftDown(const size_t& count) const {
+        Bitboard ret;
+        for (size_t idx = 0; (idx + 1) < cn_WORDS; ++idx) {
+            ret.m_words[idx] = (m_words[idx] >> count) |
+                    (m_words[idx + 1] << (cn_BITBOARD_WORD_BITS - count));
+        }
+        ret.m_words[cn_WORDS - 1] = (m_words[cn_WORDS - 1] >> count);
+        return ret;
+    }
+
+    // bitwise operators
+    constexpr Bitboard& operator|=(const Bitboard& in) {
+        for (size_t idx = 0; idx < cn_WORDS; ++idx)
+            m_words[idx] |= in.m_words[idx];
+        return *this;
+    }
+
+    constexpr Bitboard& operator&=(const Bitboard& in) {
+        for (size_t idx = 0; idx < cn_WORDS; ++idx)
+            m_words[idx] &= in.m_words[idx];
+        return *this;
+    }
+
+    constexpr Bitboard operator|(const Bitboard& in) const { Bitboard ret(*this); return (ret |= in); }
+    constexpr Bitboard operator&(const Bitboard& in) const { Bitboard ret(*this); return (ret &= in); }
+
+    constexpr bool operator==(const Bitboard& in) const {
+        for (size_t idx = 0; idx < cn_WORDS; ++idx) {
+            if (m_words[idx] != in.m_words[idx])
+                return false;
+        }
+        return true;
+    }
+
+    constexpr bool operator!=(const Bitboard& in) const { return !(*this == in); }
+
+    ~Bitboard() = default;
+private:
+    BitboardWord m_words[cn_WORDS];
+};
+
+#endif
+    // BITBOARD_H
+
+/****************************************end of file****************************************/
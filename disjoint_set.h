@@ -0,0 +1,111 @@
+/**
+ * @name disjoint_set.h
+ * @brief provides union-find structure for incremental win detection.
+ */
+#ifndef DISJOINT_SET_H
+#define DISJOINT_SET_H
+
+#include <array>
+#include <algorithm>
+#include <assert.h>
+#include <stdint.h>
+
+#include "bitboard.h"
+
+/**
+ * @brief class DisjointSet : union-find over cell ids (union by rank, with undo).
+ * @tparam Count - number of elements, every element starts in its own set.
+ * @details each placed stone is merged with its same coloured neighbours, so
+ * two cells are connected by a chain of stones exactly when they share a root.
+ *
+ * @note no path compression is applied, which keeps find() read only and
+ * every merge reversible: each successful merge is logged and rollback()
+ * pops the log back to an earlier mark(). Union by rank bounds tree depth
+ * at log2(Count). Copies are plain fixed size array copies (no allocation).
+ */
+template <size_t Count>
+class DisjointSet {
+public:
+    /// @brief DisjointSet : constructor
+    DisjointSet() :
+        m_rank{},
+        m_log_size(0) {
+        for (size_t idx = 0; idx < Count; ++idx)
+            m_parent[idx] = static_cast<CellId>(idx);
+    }
+
+    DisjointSet(const DisjointSet& in) = default;
+
+    /// @brief find : returns root of set containing id
+    /// @param id
+    /// @return CellId
+    CellId find(CellId id) const {
+        while (m_parent[id] != id)
+            id = m_parent[id];
+        return id;
+    }
+
+    /// @brief merge : joins the sets containing first and second
+    /// @param first, second
+    void merge(const CellId& first, const CellId& second) {
+        CellId root_first = find(first);
+        CellId root_second = find(second);
+
+        if (root_first == root_second)
+            return;
+
+        if (m_rank[root_first] < m_rank[root_second])
+            std::swap(root_first, root_second);
+
+        const bool rank_increased = (m_rank[root_first] == m_rank[root_second]);
+
+        m_parent[root_second] = root_first;
+        if (rank_increased)
+            m_rank[root_first]++;
+
+        m_log[m_log_size++] = MergeRecord{ root_second, rank_increased };
+    }
+
+    /// @brief connected : returns true if first and second are in the same set
+    /// @param first, second
+    /// @return true / false
+    bool connected(const CellId& first, const CellId& second) const {
+        return (find(first) == find(second));
+    }
+
+    /// @brief mark : returns current position in merge log (see rollback)
+    /// @return size_t
+    size_t mark() const { return m_log_size; }
+
+    /// @brief rollback : undoes all merges made since mark was taken
+    /// @param mark
+    void rollback(const size_t& mark) {
+        assert(mark <= m_log_size);
+        while (m_log_size > mark) {
+            const MergeRecord& record = m_log[--m_log_size];
+            const CellId root = m_parent[record.child];
+
+            m_parent[record.child] = record.child;
+            if (record.rank_increased)
+                m_rank[root]--;
+        }
+    }
+
+    ~DisjointSet() = default;
+private:
+    /// @brief MergeRecord : child root attached by a merge, for rollback
+    struct MergeRecord {
+        CellId child;
+        bool   rank_increased;
+    };
+
+    std::array<CellId, Count>       m_parent;
+    std::array<uint8_t, Count>      m_rank;
+    std::array<MergeRecord, Count>  m_log;      // at most Count - 1 successful merges
+    size_t                          m_log_size;
+};
+
+#endif
+    // DISJOINT_SET_H
+
+/****************************************end of file****************************************/
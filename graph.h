@@ -1,16 +1,17 @@
 /**
- * @name graph.h 
+ * @name graph.h
  * @brief provides graph tree for hex game.
  */
 #ifndef GRAPH_H
 #define GRAPH_H
 
 #include <vector>
-#include <memory>
 #include <assert.h> // @note replaceable with c++ assert?
 #include <stdint.h>
 
 #include "node.h"
+#include "bitboard.h"
+#include "adjacency.h"
 
 
 
@@ -18,114 +19,179 @@ using BoardSize = uint8_t;
 
 /**
  * @brief class Graph : contains map of nodes based on size.
- * @note each node contains its connections.
+ * @tparam N - board size, fixed at compile time so loop bounds, shifts and
+ * masks are all constants.
+ * @note node state is held as one bitboard per colour, connections are
+ * generated through shifts of the bitboard (see bitboard.h) or looked up in
+ * the shared adjacency table for the board size (see adjacency.h).
  *
  * @details provides basic interface for interacting with group
  * of connected nodes based on traversing algorithm, colour and position.
  */
+template <MapSize N>
 class Graph {
-public:    
+public:
     /// @brief Graph : constructor
-    /// @param MapSize - size of board parsed (relates to number of nodes)
-    Graph(const MapSize& size) :
-        m_size(size) {
-        this->m_tree.resize(m_size, std::vector<Node>(m_size));
-        for (Coordinate row_idx = 0; row_idx < m_size; ++row_idx) {
-
-            for (Coordinate col_idx = 0; col_idx < m_size; ++col_idx) {
-                Node temp(row_idx, col_idx, m_size); // build map from board size
-                this->m_tree[row_idx][col_idx] = temp;
-            }
-        }
-    }
+    Graph() = default;
 
     /// @brief Copy constructor
-    Graph(const Graph& in) :
-        m_size(in.m_size),
-        m_tree(in.m_tree) {
-    }
+    Graph(const Graph& in) = default;
 
-    Graph() = delete;
+    /// @brief getCellId : returns linear bitboard index for coordinates.
+    /// @param row, col
+    /// @return CellId
+    CellId getCellId(const Coordinate& row, const Coordinate& col) const {
+        assert((row < N) && (col < N));
+        return Adjacency<N>::getCellId(row, col);
+    }
 
-    /// @brief Clone method for copying derived class
-    std::unique_ptr<Graph> clone() const {
-        return std::make_unique<Graph>(*this);
+    /// @brief getAdjacency : returns shared connection table for board size.
+    /// @return const Adjacency<N>&
+    static const Adjacency<N>& getAdjacency() {
+        return Adjacency<N>::get();
     }
 
-    /// @brief getNode : exposes node through lookup in graph tree.
+    /// @brief getColour : returns colour of node at coordinates.
     /// @param row, col
-    /// @return Node&
-    Node& getNode(const Coordinate& row, const Coordinate& col) {
-        assert((row < this->m_size) && (col < this->m_size)); // use this API for getting node,
-        // reduces number of asserts required for accesing protected members.
-        return m_tree[row][col];
+    /// @return NodeColour
+    NodeColour getColour(const Coordinate& row, const Coordinate& col) const {
+        return this->getColour(this->getCellId(row, col));
     }
 
+    /// @brief getColour : returns colour of node at cell id.
+    /// @param id
+    /// @return NodeColour
+    NodeColour getColour(const CellId& id) const {
+        if (this->getStones(NodeColour::RED).test(id))
+            return NodeColour::RED;
+        if (this->getStones(NodeColour::GREEN).test(id))
+            return NodeColour::GREEN;
+        return NodeColour::WHITE;
+    }
 
     /// @brief isNodeFree : returns true if node is unoccupied (wraps nodeColour function).
     /// @param row, col
     /// @return true / false
-    bool isNodeFree(const Coordinate& row, const Coordinate& col) { return (isNodeColour(NodeColour::WHITE, row, col)); }
+    bool isNodeFree(const Coordinate& row, const Coordinate& col) const { return (isNodeColour(NodeColour::WHITE, row, col)); }
 
     /// @brief isNodeColour : returns true if node matches colour parameter.
     /// @param colour, row, col
     /// @return true / false
-    bool isNodeColour(const NodeColour& colour, const Coordinate& row, const Coordinate& col) {
-        return (this->getNode(row,col).getColour() == colour);
+    bool isNodeColour(const NodeColour& colour, const Coordinate& row, const Coordinate& col) const {
+        return (this->getColour(row,col) == colour);
     }
 
     /// @brief setNode : sets node colour based on coordinates.
     /// @param colour, row, col
     void setNode(const NodeColour& colour, const Coordinate& row, const Coordinate& col) {
-        this->getNode(row,col).setColour(colour);
+        this->setNode(colour, this->getCellId(row, col));
     }
 
-    /// @brief setTraverse : sets traverse member in node to block recursive loop
-    /// @param row, col
-    void setTraverse(const Coordinate& row, const Coordinate& col) {
-        this->getNode(row,col).setTraverse(true);
+    /// @brief setNode : sets node colour based on cell id.
+    /// @param colour, id
+    void setNode(const NodeColour& colour, const CellId& id) {
+        this->m_stones[0].reset(id);
+        this->m_stones[1].reset(id);
+        if (colour != NodeColour::WHITE)
+            this->m_stones[stoneIndex(colour)].set(id);
     }
 
-    /// @brief clearTraverse : clears traverse member in node to unblock recursive loop
-    /// @param row, col
-    void clearTraverse(const Coordinate& row, const Coordinate& col) {
-        this->getNode(row,col).setTraverse(false);
+    /// @brief getStones : returns bitboard of all nodes set to colour.
+    /// @param colour - RED or GREEN
+    /// @return const Bitboard<N>&
+    const Bitboard<N>& getStones(const NodeColour& colour) const {
+        return this->m_stones[stoneIndex(colour)];
     }
 
-    /// @brief getTraverse : rerturns traverse member state
-    /// @param row, col
-    /// @return true / false
-    bool getTraverse(const Coordinate& row, const Coordinate& col) {
-        return (this->getNode(row,col).getTraversed());
+    /// @brief getBorder : returns bitboard mask of nodes along given edge.
+    /// @param edge
+    /// @return const Bitboard<N>&
+    const Bitboard<N>& getBorder(const Edge& edge) const {
+        return getAdjacency().getBorder(edge);
     }
 
-    /// @brief getConnections : returns connection reference for given node
-    /// @param row, col
-    /// @return std::vector<Position> &
-    Connections& getConnections(const Coordinate& row, const Coordinate& col) {
-        return this->getNode(row,col).getConnections();
+    /// @brief getNeighbours : returns set of all nodes connected to any node in set.
+    /// @details six shifts (see Connection Algorithm), masked to valid cells.
+    /// @param set
+    /// @return Bitboard<N>
+    Bitboard<N> getNeighbours(const Bitboard<N>& set) const {
+        const CellId stride = Adjacency<N>::cn_STRIDE;
+
+        Bitboard<N> ret = set.shiftUp(1) | set.shiftDown(1);
+        ret |= set.shiftUp(stride) | set.shiftDown(stride);
+        ret |= set.shiftUp(stride - 1) | set.shiftDown(stride - 1);
+        return (ret &= getAdjacency().getCells());
     }
 
-    /// @brief getSize : returns size of graph
-    /// @return MapSize
-    MapSize getSize() const {
-        return (this->m_size);
+    /// @brief getFirstEdge : returns edge a colour starts from, GREEN left, RED top.
+    /// @param colour - RED or GREEN
+    /// @return Edge
+    static Edge getFirstEdge(const NodeColour& colour) {
+        return (colour == NodeColour::GREEN) ? Edge::LEFT : Edge::TOP;
+    }
+
+    /// @brief getSecondEdge : returns edge a colour must reach, GREEN right, RED bottom.
+    /// @param colour - RED or GREEN
+    /// @return Edge
+    static Edge getSecondEdge(const NodeColour& colour) {
+        return (colour == NodeColour::GREEN) ? Edge::RIGHT : Edge::BOTTOM;
     }
 
-    /// @brief getTree : returns reference to tree object
-    /// @details only required for pseudo copy constructors.
-    /// @return std::vector< std::vector<Node> >&
-    std::vector<std::vector<Node>>& getTree() {
-        return m_tree;
+    /// @brief findPath : returns true if colour's stones join its two edges.
+    /// @details flood fills outward from the first edge, one neighbour shift
+    /// per step, until the second edge is reached or the visited set stops
+    /// growing. The graph is only read, all traversal state lives in visited,
+    /// so any number of threads may search one shared graph at once.
+    /// @param colour - RED or GREEN
+    /// @param visited - caller owned scratch, holds reached stones on return.
+    /// @return true when path found.
+    bool findPath(const NodeColour& colour, Bitboard<N>& visited) const {
+        const Bitboard<N>& stones = this->getStones(colour);
+        const Bitboard<N>& target = this->getBorder(getSecondEdge(colour));
+
+        visited = stones & this->getBorder(getFirstEdge(colour));
+
+        while (visited.any()) {
+
+            if ((visited & target).any())
+                return true; // path found
+
+            Bitboard<N> next = (visited | this->getNeighbours(visited)) & stones;
+            if (next == visited)
+                break; // no further nodes reachable
+
+            visited = next;
+        }
+
+        return false;
+    }
+
+    /// @brief findPath : as above, using a thread local visited bitmap.
+    /// @param colour - RED or GREEN
+    /// @return true when path found.
+    bool findPath(const NodeColour& colour) const {
+        static thread_local Bitboard<N> visited;
+        return this->findPath(colour, visited);
+    }
+
+    /// @brief getSize : returns size of graph
+    /// @return MapSize
+    static constexpr MapSize getSize() {
+        return N;
     }
 
     ~Graph() { /* deconstructor */ }
 protected:
-    MapSize m_size;
-    std::vector<std::vector<Node>> m_tree;
+    Bitboard<N> m_stones[2]; // RED, GREEN
+
+    /// @brief stoneIndex : returns m_stones index for colour.
+    static uint8_t stoneIndex(const NodeColour& colour) {
+        assert(colour != NodeColour::WHITE);
+        return (colour == NodeColour::RED) ? 0 : 1;
+    }
 };
 
-#endif 
+#endif
     // GRAPH_H
 
 /************************************end of file************************************/
\ No newline at end of file
@@ -4,15 +4,15 @@
 /// @brief class : Player enumeration : provides simple interface for player API
 enum class Player : uint8_t { FIRST, SECOND };
 
-#include <memory>
-#include <vector>
+#include <array>
 #include <algorithm>
-#include <thread>
 #include <string>
 #include <utility>
 
 #include "graph.h"
-#include "probability.h"
+#include "disjoint_set.h"
+#include "zobrist.h"
+#include "random.h"
 
 /// @brief clear screen macro
 /// @note this should be compatible for both deployments, however I haven't
@@ -35,245 +35,234 @@ enum class Player : uint8_t { FIRST, SECOND };
     // SLEEP
 
 // Local constants for game constructor
-static const uint8_t cn_MAX_GAME_SIZE       = 11;
+static const uint8_t cn_MAX_GAME_SIZE       = 26;
 static const uint8_t cn_MIN_GAME_SIZE       = 3;
 static const uint8_t cn_DEFAULT_GAME_SIZE   = 7;
-static const uint8_t cn_NUM_OF_THREADS      = 10;
+
+using PlayCount = int; // play count (strong type)
 
 /**
  * @brief The HexGame class: inherits Graph class.
+ * @tparam N - board size, one instantiation per supported size (see
+ * GameDispatch), so every kernel below works on compile time bounds.
  * @details extens Graph class with game functionality.
- * @note not additional memeber variable parameters are required.
+ * @note connectivity of each player's stones is tracked in a DisjointSet
+ * which is updated by addPlay, with one virtual node per board edge.
+ * @note every play is pushed onto an undo log, undoTo() takes the game back
+ * to any earlier ply in O(plays undone).
+ * @note a Zobrist hash of the position is kept up to date by addPlay and
+ * undoPlay, one XOR per play (see hash()), along with the hash of the
+ * position rotated by 180 degrees (see canonicalHash(), isSymmetric()).
+ * @note free cells are kept in an unordered list (see getFreeCells()), a
+ * play swaps its cell to the end of the live part of the list, undo simply
+ * extends the list again.
  */
-class HexGame final : public Graph {
+template <MapSize N>
+class HexGame final : public Graph<N> {
 public:
+    static constexpr PlayCount cn_PLAY_MAXIMUM = N * N;
+
     /// @brief HexGame : constructor
-    HexGame(const BoardSize& size) :
-        Graph((static_cast<MapSize>(size))),
-        m_limits(static_cast<Coordinate>(size - 1), static_cast<Coordinate>(size - 1)) {
+    HexGame() :
+        Graph<N>() {
 
         // Set play trackers (required for monte carlo alogirithm)
         m_play_total = 0;
-        m_play_maximum = (size * size);
+        m_hash = 0;
+        m_hash_rotated = 0;
+
+        PlayCount idx = 0;
+        for (Coordinate row_idx = 0; row_idx < N; ++row_idx) {
+            for (Coordinate col_idx = 0; col_idx < N; ++col_idx) {
+                const CellId id = this->getCellId(row_idx, col_idx);
+                m_free[idx] = id;
+                m_free_index[id] = static_cast<CellId>(idx++);
+            }
+        }
     }
 
-    /// @brief Clone method for copying derived class
-    /// @details provides uinque_ptr<> object for indirection
-    /// use - required for duplicating class with base inheritence. 
-    std::unique_ptr<HexGame> clone() const {
-        return std::make_unique<HexGame>(*this);
+    /// @brief getPly : returns number of plays made (position in undo log).
+    /// @return PlayCount
+    PlayCount getPly() const {
+        return this->m_play_total;
     }
 
-    /// @brief playInterface : used to inteface for OOR move blocking and addplay check.
-    /// @param player, row, col
-    /// @return true
-    bool playInterface(const Player& player, const Coordinate& row, const Coordinate& col) {
-        return (checkInputRange(row, col) == true) ?
-                    this->addPlay(player, row, col) : (false);
+    /// @brief getMove : returns cell played at ply (from the undo log).
+    /// @param ply - less than getPly()
+    /// @return CellId
+    CellId getMove(const PlayCount& ply) const {
+        assert(ply < this->m_play_total);
+        return this->m_plays[ply].id;
     }
 
-    /// @brief computerPlay : returns computer move
-    /// @details generates move based on highest probability of win using
-    /// Monte Carlo algorithm.
-    void computerPlay() {
-        // @note in order to simplifiy the playing method during Monte Carlo
-        // prediction we create a local copy of the base class Graph's initial
-        // state. We then operate on the HexGame object as is and return
-        // the graph to its initial state prior to running the MC algorithm.
-        // This makes manipulation of the tree simplistic and intuitive, and
-        // introduces minimal overhead (we only copy the tree back after we've 
-        // decided on the best move and we can utilise the HexGame object's 
-        // methods natively while threading.)
-        // This also provides mutual exclusion between the objects being manipulated
-        // by each thread.
-
-        std::unique_ptr<Graph> clone = this->clone();
-        Graph temp_graph(*clone); // copy inherited object complete, store object for reinit later.
-        PlayCount total_temp = this->m_play_total;
-
-        std::vector<Probability> outputs; // vector storing all probability values
-
-        // Attempt to play every free position on the board.
-        for (Coordinate row_idx = 0; row_idx < this->getSize(); ++row_idx) {
-
-            for (Coordinate col_idx = 0; col_idx < this->getSize(); ++col_idx) {
-
-                if (this->isNodeFree(row_idx, col_idx)) { // Now traverse graph checking for free nodes.
-                    // test play on this position.
-                    outputs.push_back(testPlay_threaded(row_idx, col_idx));
-                    this->m_tree = temp_graph.getTree();    // reset tree to initial state.
-                    this->m_play_total = total_temp;        // reset play counter.
-                }
-            }
-        } // finish : all possible moves have been played and their probability of win stored.
+    /// @brief getFreeCells : returns pointer to first free cell id, in no particular order.
+    /// @details use with getFreeCount() for iteration, invalidated by any play.
+    /// @return const CellId*
+    const CellId * getFreeCells() const {
+        return this->m_free.data();
+    }
 
-        std::sort(outputs.begin(), outputs.end(), compareProbability());
+    /// @brief getFreeCount : returns number of free cells.
+    /// @return PlayCount
+    PlayCount getFreeCount() const {
+        return cn_PLAY_MAXIMUM - this->m_play_total;
+    }
 
-        // Add move with highest probability of winning.
-        this->addPlay(Player::SECOND, outputs[0].getRow(), outputs[0].getCol());
+    /// @brief hash : returns Zobrist hash of current position.
+    /// @details key for transposition tables, opening books and result caches.
+    /// Depends only on the stones on the board, not on the order played.
+    /// @return HashKey
+    HashKey hash() const {
+        return this->m_hash;
     }
 
-    /// @brief threadWrapper_testPlay : wrapper function for parsing result of probability
-    /// calculation through indirection.
-    /// @details reduces complexity of testPlay() method call.
-    void threadWrapper_testPlay(Probability * result, const Coordinate& row_idx, const Coordinate& col_idx) {
+    /// @brief canonicalHash : returns hash shared by position and its 180 degree rotation.
+    /// @return HashKey
+    HashKey canonicalHash() const {
+        return std::min(this->m_hash, this->m_hash_rotated);
+    }
 
-        *result = testPlay(row_idx, col_idx);
+    /// @brief getPlayHash : returns canonicalHash() of position after play, without playing it.
+    /// @param player, id - free cell
+    /// @return HashKey
+    HashKey getPlayHash(const Player& player, const CellId& id) const {
+        const NodeColour colour = this->convertPlayer(player);
+
+        return std::min(this->m_hash ^ Zobrist<N>::get().getKey(colour, id),
+                        this->m_hash_rotated ^ Zobrist<N>::get().getKey(colour, Adjacency<N>::getRotated(id)));
     }
 
-    /// @brief testPlay_Threaded : generates threads of testPlay() method calls
-    /// @details sums resulting probability and generates probability object
-    /// with average. 
-    /// @param row_idx, col_idx
-    /// @return Probability object (averaged) 
-    ///
-    /// @note each probability request is generated in a separate thread. After
-    /// all threads requests are generated, all threads are joined to main 
-    /// thread and resynchronised. After completing of synchronisation, 
-    /// thread results are averaged and returned to calling function.
-    Probability testPlay_threaded(const Coordinate& row_idx, const Coordinate& col_idx) {
-
-        // @note this could do with a move constructor.
-        std::unique_ptr<HexGame> temp = this->clone(); // returns pointer to current HexGame object.
-        std::vector<HexGame> threadObjects; // stores each HexGame object for iterating over result
-        std::vector<Probability> results(cn_NUM_OF_THREADS);
-        std::vector<std::thread> threads;
-
-        threadObjects.reserve(cn_NUM_OF_THREADS);
-        // Create MULTIPLE instances of HexGame for use in threads
-        for (int idx = 0; idx < cn_NUM_OF_THREADS; ++idx) {
-            
-            threadObjects.push_back(*temp); // generates copy of current hexGame through indirection.
+    /// @brief isSymmetric : returns true if position equals its 180 degree rotation.
+    /// @details hashes are compared first, board only scanned on a hash match.
+    /// @return true / false
+    bool isSymmetric() const {
+        if (this->m_hash != this->m_hash_rotated)
+            return false;
+
+        for (Coordinate row_idx = 0; row_idx < N; ++row_idx) {
+            for (Coordinate col_idx = 0; col_idx < N; ++col_idx) {
+                const CellId id = this->getCellId(row_idx, col_idx);
+                if (this->getColour(id) != this->getColour(Adjacency<N>::getRotated(id)))
+                    return false;
+            }
         }
+        return true;
+    }
 
-        // @note required to track results index (using a reference/iterator object threw an error in
-        // the thread library)
-        unsigned int results_idx = 0;
+    /// @brief undoPlay : takes back most recent play.
+    void undoPlay() {
+        assert(this->m_play_total > 0);
+        const PlayRecord& record = this->m_plays[--this->m_play_total];
+
+        const NodeColour colour = this->getColour(record.id);
+        this->m_hash ^= Zobrist<N>::get().getKey(colour, record.id);
+        this->m_hash_rotated ^= Zobrist<N>::get().getKey(colour, Adjacency<N>::getRotated(record.id));
+        this->setNode(NodeColour::WHITE, record.id);
+        this->m_groups.rollback(record.groups_mark);
+        // record.id still sits just past the live part of the free list (see takeFree).
+    }
 
-        threadObjects.reserve(cn_NUM_OF_THREADS);
-        // for all objects, instantiate thread
-        for (auto& a : threadObjects) {
+    /// @brief undoTo : takes back plays until ply is reached.
+    /// @param ply - earlier value of getPly()
+    void undoTo(const PlayCount& ply) {
+        assert(ply <= this->m_play_total);
+        while (this->m_play_total > ply)
+            this->undoPlay();
+    }
 
-            threads.push_back(std::thread(&HexGame::threadWrapper_testPlay, a, &results[results_idx++], row_idx, col_idx));
-        }
+    /// @brief playInterface : used to inteface for OOR move blocking and addplay check.
+    /// @param player, row, col
+    /// @return true
+    bool playInterface(const Player& player, const Coordinate& row, const Coordinate& col) {
+        return (checkInputRange(row, col) == true) ?
+                    this->addPlay(player, row, col) : (false);
+    }
 
-        // Await thread completion
-        for (auto& a : threads)
-            a.join();
+    /// @brief addPlay : add play based on coordinates if not already played.
+    /// @param player, row, col
+    /// @return true for play added.
+    bool addPlay(const Player& player, const Coordinate& row, const Coordinate& col) {
+        return (this->isNodeFree(row, col) == true) ?
+                    this->addPlay(player, this->getCellId(row, col)) : (false);
+    }
 
-        // Average results from threading calculations
-        return (averageResults(results));
+    /// @brief addPlay : add play on free cell id (no free check, search use).
+    /// @details pushes undo log, sets node, updates hashes, groups and free list.
+    /// @param player, id - by value, id may refer into getFreeCells().
+    /// @return true for play added.
+    bool addPlay(const Player& player, const CellId id) {
+        NodeColour colour = this->convertPlayer(player);
+
+        this->takeFree(id);
+        this->m_plays[this->m_play_total++] = PlayRecord{ id, static_cast<CellId>(this->m_groups.mark()) };
+        this->setNode(colour, id);
+        this->m_hash ^= Zobrist<N>::get().getKey(colour, id);
+        this->m_hash_rotated ^= Zobrist<N>::get().getKey(colour, Adjacency<N>::getRotated(id));
+        this->joinGroups(colour, id);
+        return true;
     }
 
-    /// @brief test play for given row/col on graph
-    /// @details generates probability based on number of wins / losses 
-    /// for a move at the given coordinates.
-    /// @note force player two for now
-    Probability testPlay(const Coordinate& row_idx, const Coordinate& col_idx) {
-
-        static const PlayCount cn_MAXIMUM_PLAY_LIMIT = 150; // limit for number of plays / thread
-
-        // for the requested coordinates, place first object in graph
-        this->addPlay(Player::SECOND, row_idx, col_idx);
-
-        // Create temporary graph object for reassigning values after each play attempt
-        Graph temp(*(this->clone()).release()); // copy inherited object complete, store object for recall later.
-
-        Player player = Player::SECOND; // Second player always computer (presumed, no pie rule atm).
-
-        // Counters for generating probability
-        PlayCount count = 0;
-        PlayCount wins  = 0;
-        PlayCount total_temp = this->m_play_total;
-
-        // limit = MAX for small boards, reduced for large boards to minimise calculation delay
-        PlayCount limit = (this->getSize() > 5) ?
-                    (cn_MAXIMUM_PLAY_LIMIT - 10 * (this->getSize() - 6)) :
-                    cn_MAXIMUM_PLAY_LIMIT;
-
-        // @note play count limit should be relative to size of board to reduce CPU overhead / delays
-        // when playing on large boards.
-        while (count++ < limit) {
-
-            // Generate random numbers check validity, if invalid, generate again until valid
-            // do this for ALL free nodes.
-            // Populates entire board at random.
-            for (PlayCount idx = this->m_play_total; idx < this->m_play_maximum; ) {
-           
-                // if play was valid, increment counter and play next player's move.
-                if (addPlay(player, (rand() % this->m_size), (rand() % this->m_size)) == true) {
-                    
-                    idx++;
-                    (player == Player::FIRST) ? (player = Player::SECOND) : (player = Player::FIRST);
-                } 
-            } 
-
-            // After board is populated in full, check for win condition on second player,
-            // due to the logical rules of hex, Player::FIRST must have won if
-            // Player::SECOND has not.
-            if (checkWin(Player::SECOND))
-                wins++;
-
-            // reset graph for next play round
-            player = Player::SECOND; // reset player state.
-            this->m_tree = temp.getTree();
-            this->m_play_total = total_temp; // reset play tracker.
+    /// @brief playOut : fills every free node at random, alternating players.
+    /// @details the free list is shuffled in place (Fisher-Yates) and then
+    /// played from its end, one random draw per free cell and no rejected
+    /// probes. Plays are pushed onto the undo log, callers take them back
+    /// with undoTo().
+    /// @param player - player to move first
+    /// @param random - caller's generator (one per thread)
+    /// @return winning player (board is full, so exactly one player has won)
+    Player playOut(Player player, Random& random) {
+
+        for (PlayCount idx = this->getFreeCount(); idx > 1; --idx) {
+            const PlayCount pick = static_cast<PlayCount>(random.below(static_cast<uint32_t>(idx)));
+            std::swap(m_free[idx - 1], m_free[pick]);
+            m_free_index[m_free[idx - 1]] = static_cast<CellId>(idx - 1);
+            m_free_index[m_free[pick]] = static_cast<CellId>(pick);
         }
 
-        // Return number of wins for given coordinates.
-        return Probability(static_cast<float>(wins) / (count), row_idx, col_idx);
-    }
-
-    /// @brief averageResults() : returns average result from probability threading
-    /// @return Probability object
-    Probability averageResults(std::vector<Probability>& in) {
+        // last live entry is taken each time, so takeFree() never swaps.
+        while (this->m_play_total < cn_PLAY_MAXIMUM) {
+            addPlay(player, m_free[this->getFreeCount() - 1]);
+            player = getOpponent(player);
+        }
 
-        ProbabilityValue total = 0;
-        for (auto a : in)
-            total += a.getProb();
+        // due to the logical rules of hex, Player::FIRST must have won if
+        // Player::SECOND has not.
+        return (checkWin(Player::SECOND) ? Player::SECOND : Player::FIRST);
+    }
 
-        return Probability((total / in.size()), in[0].getRow(), in[0].getCol());
+    /// @brief  convertPlayer : returns colour representation of player.
+    /// @details allows interface to be player based rather than colour based.
+    static NodeColour convertPlayer(const Player& player) {
+        return (player == Player::FIRST) ? NodeColour::GREEN : NodeColour::RED;
     }
 
+    /// @brief getOpponent : returns other player
+    /// @param player
+    /// @return Player
+    static Player getOpponent(const Player& player) {
+        return (player == Player::FIRST) ? Player::SECOND : Player::FIRST;
+    }
 
     /// @brief checkWin : check if player has won after valid play entered.
+    /// @details read only query; the player has won when both of their
+    /// virtual edge nodes share a root. Safe to call on a shared game from
+    /// any number of threads. Builds defining CHECK_WIN_PATH cross-check the
+    /// result against the stones alone with Graph::findPath() (a flood fill
+    /// per call, so off by default).
     /// @param player
     /// @return true for win.
-    bool checkWin(const Player& player) {
-
-        NodeColour colour = convertPlayer(player);
-        bool ret = false;
-        Coordinate idx;
-        CoordinatePtr row_idx, col_idx;; // pointers for indexing @todo is this the best method for handling this?
-        Coordinate zero_idx = 0;
-
-        if (player == Player::FIRST) {
-            row_idx = &idx;         // row increment check
-            col_idx = &zero_idx;
-        } else {
-            row_idx = &zero_idx;    // column increment check
-            col_idx = &idx;
-        }
+    bool checkWin(const Player& player) const {
 
-        // Attempt to traverse from top to bottom of graph or right to left (depending on player)
-        // If can't traverse first step, break out, else call findPath method to look for next step in tree.
-        for (idx = 0; idx < this->m_size; ++idx) {
+        const NodeColour colour = this->convertPlayer(player);
 
-            if ((this->isNodeColour(colour, *row_idx, *col_idx) == true) && (this->getTraverse(*row_idx, *col_idx) == false)) {
-                // set traverse block for parent node.
-                this->setTraverse(*row_idx, *col_idx);
-                // get all connected nodes and continue.
-                ret = this->findPath(colour, this->getConnections(*row_idx, *col_idx));
-                if (ret == true)
-                    break; // game won
-            } else {
+        // GREEN connects left to right, RED connects top to bottom.
+        const bool won = this->m_groups.connected(Adjacency<N>::getEdgeId(this->getFirstEdge(colour)),
+                                                  Adjacency<N>::getEdgeId(this->getSecondEdge(colour)));
 
-                continue; // check next node.
-            }
-        }
-
-        this->clearAllTraverse(); // set init state for all nodes
-        return ret;
+#ifdef CHECK_WIN_PATH
+        assert(won == this->findPath(colour));
+#endif
+        return won;
     }
 
 
@@ -282,7 +271,7 @@ public:
     /// board size.
     /// @note uses special character look up of '%', replaces character
     /// with 'R' or 'G' if set or '.' if unset.
-    void display() {
+    void display() const {
 
         CLEAR_SCREEN(); // reinit display
 
@@ -297,7 +286,7 @@ public:
         std::string space; // scope required
 
         std::string topBottom(" "); // generate border
-        buildLine(topBottom, "R ", (this->m_size + 1) * 2);
+        buildLine(topBottom, "R ", (N + 1) * 2);
 
         /// @details buildColNum : function for building column 
         /// number std::string.
@@ -306,10 +295,14 @@ public:
             std::string ret;
             int col_mod = 0;
             int row_print_val = 0;
+            size_t skip = 0; // spaces consumed by multi digit numbers (large boards)
 
             for (auto a : top) {
 
-                if (std::string(1, a).compare(" ") == 0) {
+                if (skip > 0) {
+
+                    skip--;
+                } else if (std::string(1, a).compare(" ") == 0) {
 
                     ret.append(std::string(1, a));
                 } else {
@@ -319,7 +312,9 @@ public:
 
                         if (row_print_val != limit) {
 
-                            ret.append(std::to_string(row_print_val++));
+                            std::string number = std::to_string(row_print_val++);
+                            skip = number.size() - 1;
+                            ret.append(number);
                         }
                     } else {
                         ret.append(" ");
@@ -329,27 +324,32 @@ public:
             return ret;
         };
 
+        // row numbers are padded to the width of the largest, board lines shift right to match
+        const std::string label_space(std::to_string(N - 1).size(), ' ');
+        const std::string margin(label_space.size() - 1, ' ');
+
         std::string columnNumbering = buildColNum(topBottom, this->getSize());
-        std::cout << columnNumbering << std::endl;
-        std::cout << topBottom << std::endl;
+        std::cout << margin << columnNumbering << std::endl;
+        std::cout << margin << topBottom << std::endl;
 
         std::string first(" G ");
-        buildLine(first, " % _", (this->m_size - 1));
+        buildLine(first, " % _", (N - 1));
         first.append(" \%  G"); // final
 
         std::string second(" G ");
-        buildLine(second, " \\ /", (this->m_size - 1));
+        buildLine(second, " \\ /", (N - 1));
         second.append(" \\  G");
 
         // control number of spaces from left border of console window (starts with 1 space)
         int space_idx = 1; 
 
-        for (Coordinate row_idx = 0; row_idx < this->m_size; ++row_idx) {
+        for (Coordinate row_idx = 0; row_idx < N; ++row_idx) {
             // For each instance of the key %, find and replace with . or color
             // representation if set.
             Coordinate col_idx = 0;
 
-            std::cout << static_cast<int>(row_idx); // print row number
+            const std::string label = std::to_string(row_idx);
+            std::cout << label_space.substr(label.size()) << label; // print row number
             
             for (auto a : first) {
 
@@ -376,10 +376,10 @@ public:
 
             // Buffer screen
             space = std::string(space_idx++, ' ');
-            std::cout << space << ' '; // extra space to account for row numbering
+            std::cout << space << label_space; // extra space to account for row numbering
 
             // avoid printing separator row on last instance
-            if ((row_idx + 1) != this->m_size) {
+            if ((row_idx + 1) != N) {
 
                 std::cout << second << std::endl;
                 space = std::string(space_idx++, ' ');
@@ -390,87 +390,103 @@ public:
         std::cout << topBottom << std::endl; // extra space required for indexing
 
         // print column numbering
-        std::cout << " " << space << columnNumbering << std::endl;
+        std::cout << label_space << space << columnNumbering << std::endl;
     }
 
     ~HexGame() { /* destructor */ }
 private:
-    Position  m_limits;
+    /// @brief PlayRecord : undo log entry
+    struct PlayRecord {
+        CellId id;          // cell played
+        CellId groups_mark; // m_groups merge log position before play
+    };
+
+    DisjointSet<Adjacency<N>::cn_NODE_COUNT> m_groups; // connected stone groups, see checkWin
+    std::array<PlayRecord, cn_PLAY_MAXIMUM> m_plays;   // undo log, m_play_total entries valid
+    std::array<CellId, cn_PLAY_MAXIMUM> m_free;        // free cells, getFreeCount() entries live
+    std::array<CellId, Adjacency<N>::cn_CELL_COUNT> m_free_index; // position of cell in m_free
 
     int m_play_total;
-    int m_play_maximum;
+    HashKey m_hash;         // Zobrist hash of stones on board
+    HashKey m_hash_rotated; // Zobrist hash of board rotated by 180 degrees
 
-    /// @brief  convertPlayer : returns colour representation of player.
-    /// @details allows interface to be player based rather than colour based.
-    NodeColour convertPlayer(const Player& player) const {
-        return (player == Player::FIRST) ? NodeColour::GREEN : NodeColour::RED;
+    /// @brief drawNode : updates node based on colour result
+    NodeColour drawNode(const Coordinate& row, const Coordinate& col) const {
+        return (this->getColour(row, col));
     }
 
-    /// @brief drawNode : updates node based on colour result
-    NodeColour drawNode(const Coordinate& row, const Coordinate& col) {
-        return (this->getNode(row, col).getColour());
+    /// @brief takeFree : removes cell from live part of free list.
+    /// @details cell is swapped with the last live entry and left just past
+    /// the end, where undoPlay() finds it again (plays are undone in order).
+    /// @param id - free cell (by value, may refer into m_free)
+    void takeFree(const CellId id) {
+        const CellId last_idx = static_cast<CellId>(this->getFreeCount() - 1);
+        const CellId idx = m_free_index[id];
+        const CellId last = m_free[last_idx];
+
+        m_free[idx] = last;
+        m_free_index[last] = idx;
+        m_free[last_idx] = id;
+        m_free_index[id] = last_idx;
     }
 
-    /// @brief addPlay : add play based on coordinates if not already played.
-    /// @param player, row, col
-    /// @return true for play added.
-    bool addPlay(const Player& player, const Coordinate& row, const Coordinate& col) {
-        return (this->isNodeFree(row, col) == true) ?
-                    (this->setNode(this->convertPlayer(player), row, col), this->m_play_total++, true) : (false);
+    /// @brief joinGroups : merges newly placed stone with its same coloured
+    /// neighbours, and with the virtual edge nodes it touches.
+    /// @param colour, id
+    void joinGroups(const NodeColour& colour, const CellId& id) {
+        const Adjacency<N>& adjacency = this->getAdjacency();
+        const Bitboard<N>& stones = this->getStones(colour);
+        const CellId * neighbours = adjacency.getNeighbours(id);
+
+        for (uint8_t idx = 0; idx < adjacency.getNeighbourCount(id); ++idx) {
+            if (stones.test(neighbours[idx]))
+                this->m_groups.merge(id, neighbours[idx]);
+        }
+
+        // only a player's own edges are joined, GREEN left/right, RED top/bottom.
+        const Edge first  = this->getFirstEdge(colour);
+        const Edge second = this->getSecondEdge(colour);
+
+        if (adjacency.getBorder(first).test(id))
+            this->m_groups.merge(id, adjacency.getEdgeId(first));
+        if (adjacency.getBorder(second).test(id))
+            this->m_groups.merge(id, adjacency.getEdgeId(second));
     }
 
     /// @brief checkInputRange : returns true if valid input range
-    bool checkInputRange(const Coordinate& row, const Coordinate& col) {
+    bool checkInputRange(const Coordinate& row, const Coordinate& col) const {
         return ((checkRangeSingle(row) && checkRangeSingle(col)));
     }
 
     /// @brief checkRangeSingle : returns true if input less than size
     bool checkRangeSingle(const Coordinate& input) const {
-        return (input < this->m_size);
+        return (input < N);
     }
+};
 
-    /// @brief clearAllTraverse : clears all traverse blocks in node to allow
-    /// free iteration each time.
-    void clearAllTraverse() {
-
-        for (Coordinate row_idx = 0; row_idx < this->m_size; ++row_idx) {
-            for (Coordinate col_idx = 0; col_idx < this->m_size; ++col_idx) {
-                this->clearTraverse(row_idx, col_idx);
-            }
-        }
+/**
+ * @brief GameDispatch : maps runtime board size onto its compile time HexGame<N>.
+ * @details calls Runner<N>::run(args...) for the matching size, sizes are
+ * tried from N down to cn_MIN_GAME_SIZE.
+ * @note size must already be range checked by the caller.
+ */
+template <template <MapSize> class Runner, MapSize N = cn_MAX_GAME_SIZE>
+struct GameDispatch {
+    template <typename... Args>
+    static void run(const MapSize& size, Args&&... args) {
+        if (size == N)
+            Runner<N>::run(std::forward<Args>(args)...);
+        else
+            GameDispatch<Runner, N - 1>::run(size, std::forward<Args>(args)...);
     }
+};
 
-    /// @brief findPath : breadth first recursive traverse algorithm
-    /// @param player - colour to find.
-    /// @param net - connection net.
-    /// @return true when destination found.
-    bool findPath(const NodeColour& colour, const Connections& net) {
-
-        bool ret = false;
-
-        for (auto& node : net) {
-            auto& temp = this->getNode(node.getRow(), node.getCol()); // move to new node
-
-            /// @brief build compare function
-            /// @note used to reduce condition levels below.
-            auto compare = [&]()->std::pair<int, int> {
-                return ((colour == NodeColour::GREEN) ? // green we want column index, red we want row index.
-                            std::pair<int,int>(temp.getCol(), this->m_limits.getCol()) :
-                            std::pair<int,int>(temp.getRow(), this->m_limits.getRow()));
-            };
-
-            auto result = compare();
-
-            // if new node == border node and its colour is set, game is won.
-            if ((result.first == result.second) && (temp.getColour() == colour)) {
-                ret = true; // game won
-                break;
-            } else if ((temp.getColour() == colour) && (temp.getTraversed() == false)) {
-                temp.setTraverse(true); // block
-                ret |= findPath(colour, temp.getConnections()); // recursive call for findPath.
-            }
-        }
-        return ret;
+/// @brief GameDispatch : terminator, below minimum supported size.
+template <template <MapSize> class Runner>
+struct GameDispatch<Runner, cn_MIN_GAME_SIZE - 1> {
+    template <typename... Args>
+    static void run(const MapSize&, Args&&...) {
+        assert(false); // unsupported size
     }
 };
 
@@ -1,5 +1,5 @@
 /**
-  * Simple hex board game, no swap(pie) supported, Monte Carlo algorithm
+  * Simple hex board game, no swap(pie) supported, Monte Carlo tree search
   * implemented for computer only.
   * Can be either two player (Human) or Single player with computer.
   * (Player One == Human ALWAYS), (Player Two == Human || Computer)
@@ -22,26 +22,135 @@
 #include <stdint.h>
 #include <time.h>
 #include <stdlib.h>
+#include <string.h>
 
 // local headers
 #include "hex_game.h"
+#include "mcts.h"
+
+/**
+ * @brief GameLoop : plays one game on HexGame<N> until a player wins.
+ * @tparam N - board size (selected through GameDispatch)
+ */
+template <MapSize N>
+struct GameLoop {
+    static void run(const bool& computer, const RandomSeed& seed, const size_t& threads, const SearchBudget& budget, const bool& ponder, const size_t& tree_mb) {
+
+        int row_idx, col_idx; // used for player input
+
+        HexGame<N> hex_game;
+        std::unique_ptr<MctsEngine<N>> engine; // only built for a computer player (tree memory, search threads)
+
+        if (computer == true) {
+            engine.reset(new MctsEngine<N>(seed, threads, tree_mb));
+            engine->setBudget(budget);
+        }
+
+        CLEAR_SCREEN();
+
+        Player player = Player::FIRST; // default (no swap)
+
+        while (true) {
+
+            hex_game.display();
+
+            std::cout << ((player == Player::FIRST) ? "First Player (G) Move, format: \"x, y\"" : "Second Player (R) Move, format: \"x, y\"") << std::endl;
+
+            if ((player == Player::SECOND) && (computer == true)) {
+                // Run Monte Carlo tree search for computer player
+                engine->computerPlay(hex_game, player);
+            } else {
+                // get user input for first player ALWAYS, second player only if not computer
+                std::string input;
+
+                // computer searches human's position while waiting for input.
+                if ((computer == true) && (ponder == true))
+                    engine->ponder(hex_game, player);
+
+                do {
+                    std::getline(std::cin, input);
+                } while (input.empty() == true); // catch empty triggers (terminal in linux triggers empty captures.)
+
+                if (computer == true)
+                    engine->stopPondering();
+
+                auto delim_index = input.find_first_of(',');
+                auto row_sub = input.substr(0, delim_index);
+                auto col_sub = input.substr((delim_index + 1),
+                                        std::distance(input.begin() + delim_index, input.end()));
+                std::stringstream(row_sub) >> row_idx;
+                std::stringstream(col_sub) >> col_idx;
+
+            }
+
+            // polls for computer move first, then polls for human move returns false if move invalid
+            if (((player == Player::SECOND) && computer == true) || hex_game.playInterface(player, row_idx, col_idx)) {
+
+                hex_game.display(); // draw graph
+
+                if (hex_game.checkWin(player) == true)
+                    break;
+
+                (player == Player::FIRST) ? (player = Player::SECOND) : (player = Player::FIRST);
+            }
+            else {
+
+                std::cout << "Invalid move!" << std::endl;
+                SLEEP();
+            }
+        }
+
+        // Print winner
+        std::cout << "Player " << ((player == Player::FIRST) ? "One" : "Two" ) << " has won!" << std::endl;
+    }
+};
 
 /**
  * @details on play:
  *
- * - User is prompted for board size, limit is 11, minimum is 3.
+ * - User is prompted for board size, limit is 26, minimum is 3.
  * - User must select either human input or computer input to be used for player 2.
  * - User must then input row, then column coordiantes.
  * - "Invalid Move" is printed if move not valid and player must re-enter.
+ *
+ * Options:
+ * --seed <value> : seeds computer player's random generators (default is time),
+ *                  a fixed seed repeats the same play outs only with --threads 1,
+ *                  --time-ms 0, --playouts <count> and no --ponder; otherwise
+ *                  play varies with thread and clock timing.
+ * --threads <count> : computer player's search threads (default is hardware thread count).
+ * --time-ms <ms> : computer player's time per move, 0 for no time limit (default 3000).
+ * --playouts <count> : computer player's play outs per move, 0 for no limit (default).
+ * --ponder : computer player keeps searching while the human chooses a move.
+ * --tree-mb <MB> : computer player's search tree memory ceiling (default 128).
  */
-int main(void) {
+int main(int argc, char * argv[]) {
 
     int game_size = cn_DEFAULT_GAME_SIZE;
     bool computer = false;
     bool computer_one = false;
     std::string player_select;
 
-    srand(time(static_cast<time_t>(0))); // feed seed for random number generator (used when computer playing)
+    RandomSeed seed = static_cast<RandomSeed>(time(static_cast<time_t>(0))); // used when computer playing
+    size_t threads = 0; // ThreadPool default
+    SearchBudget budget;
+    bool ponder = false;
+    size_t tree_mb = cn_TREE_MEMORY_MB;
+
+    for (int idx = 1; idx < argc; ++idx) {
+        if ((strcmp(argv[idx], "--seed") == 0) && ((idx + 1) < argc))
+            seed = strtoull(argv[++idx], nullptr, 0);
+        else if ((strcmp(argv[idx], "--threads") == 0) && ((idx + 1) < argc))
+            threads = strtoul(argv[++idx], nullptr, 10);
+        else if ((strcmp(argv[idx], "--time-ms") == 0) && ((idx + 1) < argc))
+            budget.time_ms = atoi(argv[++idx]);
+        else if ((strcmp(argv[idx], "--playouts") == 0) && ((idx + 1) < argc))
+            budget.playouts = strtoull(argv[++idx], nullptr, 10);
+        else if (strcmp(argv[idx], "--ponder") == 0)
+            ponder = true;
+        else if ((strcmp(argv[idx], "--tree-mb") == 0) && ((idx + 1) < argc))
+            tree_mb = strtoul(argv[++idx], nullptr, 10);
+    }
 
     CLEAR_SCREEN();
     std::cout << "Hex Game : S. Whittaker (2018)" << std::endl;
@@ -64,58 +173,10 @@ int main(void) {
         computer = true;
     }
 
-    int row_idx, col_idx; // used for player input
-
-    HexGame hex_game(((game_size <= cn_MAX_GAME_SIZE) && (game_size >= cn_MIN_GAME_SIZE) ? game_size : cn_DEFAULT_GAME_SIZE));
-
-    CLEAR_SCREEN();
-
-    Player player = Player::FIRST; // default (no swap)
-
-    while (true) {
-
-        hex_game.display();
-
-        std::cout << ((player == Player::FIRST) ? "First Player (G) Move, format: \"x, y\"" : "Second Player (R) Move, format: \"x, y\"") << std::endl;
-
-        if ((player == Player::SECOND) && (computer == true)) {
-            // Run Monte Carlo algorithm for computer player
-            hex_game.computerPlay();
-        } else {
-            // get user input for first player ALWAYS, second player only if not computer
-            std::string input;
-            do {
-                std::getline(std::cin, input);
-            } while (input.empty() == true); // catch empty triggers (terminal in linux triggers empty captures.)
-
-            auto delim_index = input.find_first_of(',');
-            auto row_sub = input.substr(0, delim_index);
-            auto col_sub = input.substr((delim_index + 1),
-                                    std::distance(input.begin() + delim_index, input.end()));
-            std::stringstream(row_sub) >> row_idx;
-            std::stringstream(col_sub) >> col_idx;
-
-        }
-
-        // polls for computer move first, then polls for human move returns false if move invalid
-        if (((player == Player::SECOND) && computer == true) || hex_game.playInterface(player, row_idx, col_idx)) {
-
-            hex_game.display(); // draw graph
-
-            if (hex_game.checkWin(player) == true)
-                break;
-
-            (player == Player::FIRST) ? (player = Player::SECOND) : (player = Player::FIRST);
-        }
-        else {
-
-            std::cout << "Invalid move!" << std::endl;
-            SLEEP();
-        }
-    }
+    int size = ((game_size <= cn_MAX_GAME_SIZE) && (game_size >= cn_MIN_GAME_SIZE) ? game_size : cn_DEFAULT_GAME_SIZE);
 
-    // Print winner
-    std::cout << "Player " << ((player == Player::FIRST) ? "One" : "Two" ) << " has won!" << std::endl;
+    // run game loop on HexGame instantiation for selected size
+    GameDispatch<GameLoop>::run(static_cast<MapSize>(size), computer, seed, threads, budget, ponder, tree_mb);
 
     return 0;
 }
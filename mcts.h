@@ -0,0 +1,954 @@
+/**
+ * @name mcts.h
+ * @brief provides Monte Carlo tree search (UCT) engine for computer player.
+ */
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <vector>
+#include <array>
+#include <memory>
+#include <cmath>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <stdint.h>
+
+#include "hex_game.h"
+#include "probability.h"
+#include "pool.h"
+#include "random.h"
+#include "thread_pool.h"
+#include "node_store.h"
+#include "transposition_table.h"
+#include "priors.h"
+
+using PlayoutCount = uint64_t;
+using Clock = std::chrono::steady_clock;
+
+// Search constants
+static const int        cn_MOVE_TIME_MS     = 3000;     // default computer move time budget
+static const float      cn_UCT_EXPLORATION  = 0.7f;     // UCT exploration constant (C)
+static const VisitCount cn_EXPAND_VISITS    = 8;        // leaf visits before its children are created
+static const size_t     cn_TREE_MEMORY_MB   = 128;      // default node storage ceiling per engine
+static const float      cn_RECYCLE_LOAD     = 0.75f;    // store fraction in use that triggers recycling
+static const float      cn_RECYCLE_TARGET   = 0.5f;     // store fraction kept by recycling
+static const float      cn_TABLE_SHARE      = 0.25f;    // tree memory given to the transposition table
+static const size_t     cn_SEARCH_BATCH     = 32;       // iterations per scheduled search task
+static const float      cn_RAVE_EQUIVALENCE = 1000.0f;  // visits at which tree and AMAF values weigh equally (k)
+static const VisitCount cn_VIRTUAL_LOSS     = 3;        // visits (without wins) added to a node while a thread is below it
+static const VisitCount cn_PRIOR_VISITS     = 20;       // AMAF visits a child's prior (see MovePriors) counts as, above 0
+static const NodeIndex  cn_WIDEN_MINIMUM    = 4;        // children considered by a newly expanded node
+
+/**
+ * @brief SearchBudget : limits for one computerPlay() search, 0 disables a limit.
+ * @details search stops at whichever limit is reached first; with both
+ * limits disabled cn_MOVE_TIME_MS applies.
+ */
+struct SearchBudget {
+    int          time_ms  = cn_MOVE_TIME_MS; // wall clock per move
+    PlayoutCount playouts = 0;               // iterations per move, over all threads
+};
+
+/**
+ * @brief SearchWorker : per thread search state (generator, path and position hashes).
+ * @tparam N - board size
+ * @note one per pool worker, used by one search task at a time.
+ */
+template <MapSize N>
+struct SearchWorker {
+    Random random;                                                // play out generator
+    std::array<NodeIndex, HexGame<N>::cn_PLAY_MAXIMUM + 1> path;  // nodes visited this iteration
+    std::array<HashKey, HexGame<N>::cn_PLAY_MAXIMUM + 1> keys;    // canonical hash of each path position
+};
+
+/**
+ * @brief class MctsTree : UCT search tree shared by all search threads.
+ * @tparam N - board size
+ *
+ * @details each iteration:
+ *     selection       - root picks its least visited active move (see keepRootMoves(),
+ *                       setRootHalving()), below it descend picking the child with highest value,
+ *                       (1 - b) * Q + b * Q_amaf + C * sqrt(ln(parent visits) / (visits + 1))
+ *                       with b = sqrt(k / (3 * visits + k)) (RAVE). Q is taken from
+ *                       the transposition table when its position has seen more
+ *                       play outs (over every move order) than the node itself.
+ *     expansion       - leaf with cn_EXPAND_VISITS visits gets one child per free cell,
+ *                       ordered best prior first (see MovePriors), the prior
+ *                       seeding its AMAF statistics as cn_PRIOR_VISITS play outs.
+ *     widening        - below the root only the first
+ *                       cn_WIDEN_MINIMUM + sqrt(parent visits) children are
+ *                       considered, so new nodes search their likely moves
+ *                       first and admit the rest as visits grow.
+ *     play out        - HexGame::playOut() fills the rest of the board at random.
+ *     backpropagation - every node on the path gets a visit, and a win if its
+ *                       move was made by the play out winner. Every child of a
+ *                       node on the path whose cell ended up owned by the player
+ *                       choosing at that node gets an AMAF visit (and win), so
+ *                       one play out informs every move the winner occupied.
+ *                       Every position on the path below the root is credited
+ *                       in the transposition table.
+ *     solving         - a move that wins at once is proven a WIN, a node with a
+ *                       WIN child is proven a LOSS and one whose every child is
+ *                       a LOSS is proven a WIN (MCTS-Solver), propagated up the
+ *                       path. Selection skips lost children and takes a won one,
+ *                       a proven node is scored as its result without a play out.
+ *
+ * @note tree parallel: any number of threads run iterations at once, each
+ * with its own SearchWorker and working board. A node's visits are raised
+ * by cn_VIRTUAL_LOSS as a thread descends through it (a loss until the play
+ * out returns), steering other threads onto different lines. Expansion is
+ * claimed with a compare exchange, threads that lose treat the node as a
+ * leaf; child blocks are carved from the NodeStore with one atomic add.
+ * @note memory is bounded: both node stores (live and compaction target)
+ * are sized from a ceiling at construction. Once the live store passes
+ * cn_RECYCLE_LOAD (see needsRecycle()), recycle() drops the children of the
+ * least visited expanded nodes (they become leaves again) until
+ * cn_RECYCLE_TARGET remains; the engine pauses its search to call it.
+ * @note transpositions: nodes stay a tree (one per move sequence), while
+ * position statistics are shared through a TranspositionTable keyed by
+ * canonical hash, so transposed and rotated lines pool their play outs. The
+ * table takes cn_TABLE_SHARE of the memory ceiling and outlives reset(),
+ * advance() and recycle(), its statistics stay valid for any later search.
+ * @note plays made during an iteration are taken back through the HexGame
+ * undo log, the working board is only copied once per run() batch.
+ * @note reset(), advance(), recycle(), keepRootMoves() and reviveRootMoves()
+ * require no search running.
+ */
+template <MapSize N>
+class MctsTree {
+public:
+    /// @brief MctsTree : constructor, store pages are only touched as nodes are used.
+    /// @param memory_mb - ceiling for node storage, see getCapacity().
+    explicit MctsTree(const size_t& memory_mb = cn_TREE_MEMORY_MB) :
+        m_nodes(getCapacity(memory_mb)),
+        m_scratch(getCapacity(memory_mb)),
+        m_table(static_cast<size_t>((memory_mb << 20) * cn_TABLE_SHARE) / TranspositionTable::cn_ENTRY_BYTES) {
+    }
+
+    MctsTree(const MctsTree&) = delete;
+    MctsTree& operator=(const MctsTree&) = delete;
+
+    /// @brief getCapacity : returns nodes per store that fit in memory ceiling.
+    /// @details each node costs two store entries and a compaction index,
+    /// out of the memory not given to the table. At least a few full
+    /// expansions always fit.
+    /// @param memory_mb
+    /// @return NodeIndex
+    static NodeIndex getCapacity(const size_t& memory_mb) {
+        const size_t bytes = static_cast<size_t>((memory_mb << 20) * (1.0f - cn_TABLE_SHARE));
+        const size_t nodes = bytes / ((2 * NodeStore::cn_NODE_BYTES) + sizeof(NodeIndex));
+        const size_t minimum = 4 * (HexGame<N>::cn_PLAY_MAXIMUM + 1);
+        const size_t maximum = NodeIndex(~0u) / 2;
+
+        return static_cast<NodeIndex>(std::min(std::max(nodes, minimum), maximum));
+    }
+
+    /// @brief reset : discards tree, ready to search a new root position.
+    /// @param player - player to move at root.
+    void reset(const Player player) {
+        this->m_player = player;
+        this->m_nodes.clear();
+    }
+
+    /// @brief advance : re-roots tree at the position reached by moves.
+    /// @details the subtree under the last move is compacted to the front of
+    /// the store, keeping its statistics; every other node is dropped.
+    /// @param root - position reached (moves are its last plays).
+    /// @param ply - root ply of existing tree, moves are root->getMove(ply) onwards.
+    /// @param player - player to move at new root.
+    /// @return true if reused, false if a move was never searched (tree unchanged).
+    bool advance(const HexGame<N>& root, const PlayCount& ply, const Player player) {
+        if (this->m_nodes.getSize() == 0)
+            return false;
+
+        NodeIndex node = 0;
+
+        for (PlayCount idx = ply; idx < root.getPly(); ++idx) {
+            const CellId move = root.getMove(idx);
+            NodeIndex next = 0;
+
+            if (this->m_nodes.isExpanded(node) == false)
+                return false;
+
+            for (NodeIndex child = this->m_nodes.getFirstChild(node); child < this->m_nodes.getChildEnd(node); ++child) {
+                if (this->m_nodes.getMove(child) == move)
+                    next = child;
+            }
+
+            if (next == 0)
+                return false;
+            node = next;
+        }
+
+        this->m_player = player;
+
+        if (node != 0)
+            this->compact(node, 0);
+
+        this->setRootMoves();
+        return true;
+    }
+
+    /// @brief recycle : drops least visited subtrees once store passes cn_RECYCLE_LOAD.
+    /// @details root and its children are always kept, active root moves are unchanged.
+    /// @return true if nodes were recycled.
+    bool recycle() {
+        if (this->needsRecycle() == false)
+            return false;
+
+        this->compact(0, this->getRecycleThreshold(static_cast<NodeIndex>(this->m_nodes.getCapacity() * cn_RECYCLE_TARGET)));
+        return true;
+    }
+
+    /// @brief needsRecycle : returns true once store passes cn_RECYCLE_LOAD (safe during search).
+    bool needsRecycle() const {
+        return (this->m_nodes.getSize() > static_cast<NodeIndex>(this->m_nodes.getCapacity() * cn_RECYCLE_LOAD));
+    }
+
+    /// @brief keepRootMoves : narrows active root moves to those in keep.
+    /// @details only active moves are selected at the root, subtrees of
+    /// dropped moves are kept but no longer searched.
+    /// @param keep - cells of root moves to keep active
+    void keepRootMoves(const Bitboard<N>& keep) {
+        this->m_root_moves &= keep;
+        this->reviveRootMoves();
+    }
+
+    /// @brief reviveRootMoves : re-activates every root move not proven lost once all active moves are.
+    /// @details a dropped move may still be unproven when the kept ones are
+    /// all proven lost, the root is then not solved and the dropped moves
+    /// are the only ones worth searching or playing.
+    void reviveRootMoves() {
+        const NodeIndex first = this->m_nodes.getFirstChild(0);
+        const NodeIndex end = this->m_nodes.getChildEnd(0);
+        bool lost = true;
+
+        for (NodeIndex idx = first; idx < end; ++idx) {
+            if (this->m_root_moves.test(this->m_nodes.getMove(idx)) && (this->m_nodes.getProof(idx) != NodeProof::LOSS))
+                lost = false;
+        }
+
+        this->m_root_active = 0;
+        for (NodeIndex idx = first; idx < end; ++idx) {
+            if (lost && (this->m_nodes.getProof(idx) != NodeProof::LOSS))
+                this->m_root_moves.set(this->m_nodes.getMove(idx));
+            if (this->m_root_moves.test(this->m_nodes.getMove(idx)))
+                this->m_root_active++;
+        }
+    }
+
+    /// @brief setRootHalving : sets whether the root spreads play outs evenly over its active moves.
+    /// @details on by default, for sequential halving; off while pondering,
+    /// where the root selects by value like any other node so play outs go
+    /// to the opponent's likely replies, whose subtrees advance() keeps.
+    /// @param halving
+    void setRootHalving(const bool& halving) { this->m_root_halving = halving; }
+
+    /// @brief setSymmetryPruning : sets whether a symmetric root gets one move of each rotated pair.
+    /// @details on by default; off while pondering, where every reply the
+    /// opponent may play must have its own subtree for advance() to keep.
+    /// Applies to the next root expansion.
+    /// @param prune
+    void setSymmetryPruning(const bool& prune) { this->m_prune_symmetric = prune; }
+
+    /// @brief getRootActive : returns number of active root moves (0 before root expanded).
+    uint16_t getRootActive() const { return this->m_root_active; }
+
+    /// @brief isRootSolved : returns true once the root position is proven, no further search is needed.
+    bool isRootSolved() const { return (this->m_nodes.getSize() > 0) && this->m_nodes.isProven(0); }
+
+    /// @brief isRootActive : returns true if root move is still selected.
+    bool isRootActive(const CellId& move) const { return this->m_root_moves.test(move); }
+
+    /// @brief run : runs a batch of iterations from root position.
+    /// @details working board is taken from the calling thread's pool. The
+    /// root is expanded by the first batch after reset() or advance(), which
+    /// must complete before other threads search.
+    /// @param root - position to search (read only, same for every batch).
+    /// @param iterations
+    /// @param worker - calling thread's search state
+    void run(const HexGame<N> * root, const size_t& iterations, SearchWorker<N>& worker) {
+
+        auto game = ObjectPool<HexGame<N>>::local().acquire();
+        *game = *root;
+
+        if (this->m_nodes.getSize() == 0)
+            this->m_nodes.init(this->m_nodes.allocate(1), 0);
+
+        if (this->m_nodes.claim(0)) {
+            this->expand(0, *game, this->m_player);
+            this->setRootMoves();
+        }
+
+        for (size_t idx = 0; idx < iterations; ++idx)
+            this->iterate(*game, worker);
+    }
+
+    /// @brief getNodes : returns node store (root == 0)
+    const NodeStore& getNodes() const { return this->m_nodes; }
+
+    ~MctsTree() = default;
+private:
+    NodeStore m_nodes;                       // live tree
+    NodeStore m_scratch;                     // compaction target, swapped with m_nodes
+    TranspositionTable m_table;              // position statistics, shared by transpositions
+    std::vector<NodeIndex> m_source;         // compaction: original index of each m_scratch node
+    std::vector<std::pair<VisitCount, uint16_t>> m_expanded; // recycling: visits and child count of expanded nodes
+    Bitboard<N> m_root_moves;                // active root moves
+    bool m_prune_symmetric = true;           // see setSymmetryPruning()
+    bool m_root_halving = true;              // see setRootHalving()
+    uint16_t m_root_active = 0;
+    Player m_player = Player::SECOND;
+
+    /// @brief setRootMoves : makes every root child active.
+    void setRootMoves() {
+        this->m_root_moves = Bitboard<N>();
+        for (NodeIndex idx = this->m_nodes.getFirstChild(0); idx < this->m_nodes.getChildEnd(0); ++idx)
+            this->m_root_moves.set(this->m_nodes.getMove(idx));
+        this->m_root_active = this->m_nodes.getChildCount(0);
+    }
+
+    /// @brief compact : copies subtree of root into a fresh store, breadth first.
+    /// @details children of a node below the root are kept only if it has at
+    /// least threshold visits, otherwise it becomes a leaf. Child blocks stay
+    /// contiguous, node becomes the new root (index 0).
+    /// @param root - node to become root
+    /// @param threshold - 0 keeps every expanded node
+    void compact(const NodeIndex& root, const VisitCount& threshold) {
+        this->m_source.clear();
+        this->m_source.push_back(root);
+
+        for (size_t idx = 0; idx < this->m_source.size(); ++idx) {
+            const NodeIndex original = this->m_source[idx];
+            const NodeIndex copy = static_cast<NodeIndex>(idx);
+
+            this->m_scratch.copy(this->m_nodes, original, copy);
+
+            if (this->m_nodes.isExpanded(original) &&
+                    ((idx == 0) || (this->m_nodes.getVisits(original) >= threshold))) {
+                this->m_scratch.publish(copy, static_cast<NodeIndex>(this->m_source.size()), this->m_nodes.getChildCount(original));
+
+                for (NodeIndex child = this->m_nodes.getFirstChild(original); child < this->m_nodes.getChildEnd(original); ++child)
+                    this->m_source.push_back(child);
+            } else {
+                this->m_scratch.setLeaf(copy); // includes FULL nodes, which may now fit
+            }
+        }
+
+        this->m_nodes.swap(this->m_scratch);
+        this->m_nodes.setSize(static_cast<NodeIndex>(this->m_source.size()));
+    }
+
+    /// @brief getRecycleThreshold : returns visits a node needs to keep its children.
+    /// @details expanded nodes are ranked by visits, children are kept for the
+    /// most visited until target nodes would be exceeded.
+    /// @param target - nodes to keep at most
+    /// @return VisitCount
+    VisitCount getRecycleThreshold(const NodeIndex& target) {
+        this->m_expanded.clear();
+        this->m_source.clear();
+        this->m_source.push_back(0);
+
+        for (size_t idx = 0; idx < this->m_source.size(); ++idx) {
+            const NodeIndex node = this->m_source[idx];
+
+            if (this->m_nodes.isExpanded(node) == false)
+                continue;
+
+            if (idx > 0)
+                this->m_expanded.emplace_back(this->m_nodes.getVisits(node), this->m_nodes.getChildCount(node));
+
+            for (NodeIndex child = this->m_nodes.getFirstChild(node); child < this->m_nodes.getChildEnd(node); ++child)
+                this->m_source.push_back(child);
+        }
+
+        std::sort(this->m_expanded.begin(), this->m_expanded.end(),
+                [](const std::pair<VisitCount, uint16_t>& lhs, const std::pair<VisitCount, uint16_t>& rhs) {
+                    return (lhs.first > rhs.first);
+                });
+
+        NodeIndex kept = 1 + this->m_nodes.getChildCount(0);
+        for (const auto& node : this->m_expanded) {
+            if ((kept + node.second) > target)
+                return node.first + 1;
+            kept += node.second;
+        }
+        return 0;
+    }
+
+    /// @brief iterate : one selection, expansion, play out, backpropagation pass.
+    /// @param game - working board at root position, returned there.
+    /// @param worker
+    void iterate(HexGame<N>& game, SearchWorker<N>& worker) {
+        const PlayCount root_ply = game.getPly();
+
+        NodeIndex node = 0;
+        size_t depth = 0;
+        Player player = this->m_player; // player to move at node
+        bool terminal = false;
+        Player winner = player;
+
+        this->m_nodes.addVisits(node, cn_VIRTUAL_LOSS);
+        worker.path[depth++] = node;
+
+        // selection (and expansion of leaf once visited often enough)
+        while (terminal == false) {
+
+            if (this->m_nodes.isProven(node)) {
+                terminal = true; // result known, node's move was played by the opponent of player
+                winner = (this->m_nodes.getProof(node) == NodeProof::WIN) ? HexGame<N>::getOpponent(player) : player;
+                break;
+            }
+
+            if ((this->m_nodes.isExpanded(node) == false) && (this->tryExpand(node, game, player) == false))
+                break; // leaf
+
+            node = this->select(node, game, player);
+            game.addPlay(player, this->m_nodes.getMove(node));
+            this->m_nodes.addVisits(node, cn_VIRTUAL_LOSS);
+            worker.keys[depth] = game.canonicalHash();
+            worker.path[depth++] = node;
+
+            if (game.checkWin(player)) {
+                terminal = true; // game decided inside tree
+                winner = player;
+                this->m_nodes.setProof(node, NodeProof::WIN);
+            }
+            player = HexGame<N>::getOpponent(player);
+        }
+
+        // play out
+        if (terminal == false)
+            winner = game.playOut(player, worker.random);
+
+        // backpropagation : node at odd depth was played by root player,
+        // virtual loss is turned back into a single visit.
+        for (size_t idx = 0; idx < depth; ++idx) {
+            const Player mover = (idx % 2 == 1) ? this->m_player : HexGame<N>::getOpponent(this->m_player);
+
+            this->m_nodes.subVisits(worker.path[idx], cn_VIRTUAL_LOSS - 1);
+            if (mover == winner)
+                this->m_nodes.addWin(worker.path[idx]);
+            if (idx > 0)
+                this->m_table.update(worker.keys[idx], (mover == winner));
+        }
+
+        this->updateAmaf(game, worker, depth, winner);
+
+        for (size_t idx = depth - 1; (idx > 0) && this->solve(worker.path[idx - 1], worker.path[idx]); --idx) {
+        }
+
+        game.undoTo(root_ply);
+    }
+
+    /// @brief solve : proves parent from a newly proven child.
+    /// @details a WIN child (for the player to move at parent) makes parent
+    /// a LOSS for whoever played into it; parent is a WIN once every child
+    /// is a LOSS. Hex has no draws, so no other outcome exists.
+    /// @param parent, child
+    /// @return true if parent is now proven.
+    bool solve(const NodeIndex& parent, const NodeIndex& child) {
+        const NodeProof proof = this->m_nodes.getProof(child);
+
+        if (proof == NodeProof::WIN) {
+            this->m_nodes.setProof(parent, NodeProof::LOSS);
+            return true;
+        }
+
+        if ((proof == NodeProof::UNKNOWN) || (this->m_nodes.isExpanded(parent) == false))
+            return false;
+
+        for (NodeIndex idx = this->m_nodes.getFirstChild(parent); idx < this->m_nodes.getChildEnd(parent); ++idx) {
+            if (this->m_nodes.getProof(idx) != NodeProof::LOSS)
+                return false;
+        }
+
+        this->m_nodes.setProof(parent, NodeProof::WIN);
+        return true;
+    }
+
+    /// @brief updateAmaf : credits AMAF statistics from final board of iteration.
+    /// @details a child's move counts as played "first" if its cell is owned
+    /// by the player choosing at the parent; only cells that were free at the
+    /// parent are children, so ownership means it was played there later.
+    /// @param game - final board
+    /// @param worker - path of iteration
+    /// @param depth - nodes on path.
+    /// @param winner
+    void updateAmaf(const HexGame<N>& game, const SearchWorker<N>& worker, const size_t& depth, const Player& winner) {
+
+        for (size_t idx = 0; idx < depth; ++idx) {
+            const NodeIndex parent = worker.path[idx];
+            const Player chooser = (idx % 2 == 0) ? this->m_player : HexGame<N>::getOpponent(this->m_player);
+            const Bitboard<N>& stones = game.getStones(HexGame<N>::convertPlayer(chooser));
+
+            if (this->m_nodes.isExpanded(parent) == false)
+                continue; // leaf, or expanded by another thread but not yet published
+
+            for (NodeIndex child = this->m_nodes.getFirstChild(parent); child < this->m_nodes.getChildEnd(parent); ++child) {
+                if (stones.test(this->m_nodes.getMove(child)))
+                    this->m_nodes.addAmaf(child, (chooser == winner));
+            }
+        }
+    }
+
+    /// @brief select : returns child with highest RAVE / UCT value.
+    /// @details unvisited children are ranked on AMAF value alone, which
+    /// starts at their prior (see expand()). At the root (unless halving is
+    /// off, see setRootHalving()) the least visited active move is returned, spreading each halving round's
+    /// budget evenly over the remaining candidates, every child is eligible
+    /// there (see keepRootMoves()), and dropped moves are searched again once
+    /// every active move is proven lost (see reviveRootMoves()); elsewhere
+    /// only the widened prefix is, extended past lost children until one
+    /// unproven child is found.
+    /// A proven WIN child is returned at once, LOSS children are skipped
+    /// unless nothing else is left.
+    /// @param parent - expanded node
+    /// @param game - working board at parent position
+    /// @param player - player to move at parent
+    /// @return NodeIndex
+    NodeIndex select(const NodeIndex& parent, const HexGame<N>& game, const Player& player) const {
+        const NodeIndex first = this->m_nodes.getFirstChild(parent);
+        const NodeIndex end = this->m_nodes.getChildEnd(parent);
+
+        if ((parent == 0) && this->m_root_halving) {
+            NodeIndex least = end;   // least visited unproven active move
+            NodeIndex dropped = end; // least visited unproven dropped move
+
+            for (NodeIndex idx = first; idx < end; ++idx) {
+                const NodeProof proof = this->m_nodes.getProof(idx);
+
+                if (proof == NodeProof::WIN)
+                    return idx;
+                if (proof == NodeProof::LOSS)
+                    continue;
+
+                NodeIndex& candidate = this->m_root_moves.test(this->m_nodes.getMove(idx)) ? least : dropped;
+                if ((candidate == end) || (this->m_nodes.getVisits(idx) < this->m_nodes.getVisits(candidate)))
+                    candidate = idx;
+            }
+            return (least != end) ? least : (dropped != end) ? dropped : first;
+        }
+
+        const VisitCount parent_visits = this->m_nodes.getVisits(parent);
+        const float log_visits = std::log(static_cast<float>(parent_visits + 1));
+        const NodeIndex width = cn_WIDEN_MINIMUM + static_cast<NodeIndex>(std::sqrt(static_cast<float>(parent_visits)));
+        const NodeIndex widened = ((end - first) > width) ? (first + width) : end;
+
+        NodeIndex best = first;
+        float best_value = -1.0f;
+
+        for (NodeIndex idx = first; idx < end; ++idx) {
+            const NodeProof proof = this->m_nodes.getProof(idx);
+
+            if (proof == NodeProof::WIN)
+                return idx; // parent is lost, proven on backpropagation
+            if (proof == NodeProof::LOSS)
+                continue;
+            if ((idx >= widened) && (best_value >= 0.0f))
+                break;
+
+            const float visits = static_cast<float>(this->m_nodes.getVisits(idx));
+            const float beta = std::sqrt(cn_RAVE_EQUIVALENCE / ((3.0f * visits) + cn_RAVE_EQUIVALENCE));
+            float tree_value = (visits > 0.0f) ? (this->m_nodes.getWins(idx) / visits) : 0.0f;
+            VisitCount table_visits = 0;
+            VisitCount table_wins = 0;
+
+            if ((visits > 0.0f) &&
+                    this->m_table.find(game.getPlayHash(player, this->m_nodes.getMove(idx)), table_visits, table_wins) &&
+                    (table_visits > visits))
+                tree_value = static_cast<float>(table_wins) / table_visits; // transpositions add play outs
+
+            const float amaf_value = static_cast<float>(this->m_nodes.getAmafWins(idx)) / this->m_nodes.getAmafVisits(idx);
+
+            const float value = ((1.0f - beta) * tree_value) + (beta * amaf_value) +
+                    cn_UCT_EXPLORATION * std::sqrt(log_visits / (visits + 1.0f));
+
+            if (value > best_value) {
+                best_value = value;
+                best = idx;
+            }
+        }
+        return best;
+    }
+
+    /// @brief tryExpand : expands leaf once visited often enough, unless another thread is.
+    /// @param node - leaf
+    /// @param game - working board at node position
+    /// @param player - player to move at node
+    /// @return true if node is now expanded by this thread.
+    bool tryExpand(const NodeIndex& node, const HexGame<N>& game, const Player& player) {
+        if (this->m_nodes.getVisits(node) < cn_EXPAND_VISITS)
+            return false;
+
+        if (this->m_nodes.claim(node) == false)
+            return false;
+
+        return this->expand(node, game, player);
+    }
+
+    /// @brief expand : adds one child per free cell of working board, then publishes them.
+    /// @details caller must have claimed the node. Children are stored best
+    /// prior first, with the prior as their starting AMAF statistics. On a
+    /// symmetric root only one move of each rotated pair is added (unless
+    /// disabled, see setSymmetryPruning()).
+    /// @param parent
+    /// @param game - working board at parent position
+    /// @param player - player to move at parent
+    /// @return true if children added (false when store full or board full, node marked FULL).
+    bool expand(const NodeIndex& parent, const HexGame<N>& game, const Player& player) {
+        const bool symmetric = (parent == 0) && this->m_prune_symmetric && game.isSymmetric();
+        const CellId * free_cells = game.getFreeCells();
+        const PlayCount count = game.getFreeCount();
+        const NodeIndex first = (count > 0) ? this->m_nodes.allocate(static_cast<NodeIndex>(count)) : this->m_nodes.getCapacity();
+
+        if (first == this->m_nodes.getCapacity()) {
+            this->m_nodes.markFull(parent);
+            return false;
+        }
+
+        const MovePriors<N> priors(game, player);
+        std::array<std::pair<float, CellId>, HexGame<N>::cn_PLAY_MAXIMUM> moves;
+        uint16_t added = 0;
+
+        for (PlayCount idx = 0; idx < count; ++idx) {
+            const CellId id = free_cells[idx];
+
+            if ((symmetric == false) || (id <= Adjacency<N>::getRotated(id)))
+                moves[added++] = std::make_pair(priors.get(id), id);
+        }
+
+        // ties broken by cell id, std::sort needs no buffer (std::stable_sort allocates one)
+        std::sort(moves.begin(), moves.begin() + added,
+                [](const std::pair<float, CellId>& lhs, const std::pair<float, CellId>& rhs) {
+                    return (lhs.first > rhs.first) || ((lhs.first == rhs.first) && (lhs.second < rhs.second));
+                });
+
+        for (uint16_t idx = 0; idx < added; ++idx) {
+            this->m_nodes.init(first + idx, moves[idx].second);
+            this->m_nodes.setPrior(first + idx, cn_PRIOR_VISITS,
+                                   static_cast<VisitCount>((moves[idx].first * cn_PRIOR_VISITS) + 0.5f));
+        }
+
+        this->m_nodes.publish(parent, first, added);
+        return true;
+    }
+};
+
+/**
+ * @brief class MctsEngine : computer player, tree parallel UCT search.
+ * @tparam N - board size
+ *
+ * @details every pool worker searches the same shared tree (see MctsTree)
+ * until the move budget (see SearchBudget) is spent, so extra threads deepen
+ * one tree rather than repeat shallow estimates. Search is anytime, the best
+ * move found when the budget runs out is played.
+ * @details root moves are chosen by sequential halving: the budget is split
+ * into ceil(log2(root moves)) equal rounds, each round spreads its play outs
+ * evenly over the active root moves, then the worse half (by mean) is
+ * dropped. The best mean among the final round's moves is played.
+ * @details once the root is proven (see MctsTree, solving) search stops:
+ * a winning move is played at once, and a lost position plays its best
+ * mean move without spending the rest of the budget.
+ * @details the tree is kept between moves: when the position searched last
+ * is reached again after the engine's move and the opponent's reply (found
+ * through the game's undo log and hash), the tree is re-rooted at that
+ * reply's subtree instead of starting empty. Tree memory is recycled (see
+ * MctsTree::recycle()) before each search, between halving rounds and
+ * whenever the store fills during a search: every chain stops after its
+ * batch, the last to stop recycles and restarts them all.
+ * @details pondering: ponder() searches the opponent's position in the
+ * background while they choose a move, stopPondering() ends it and the
+ * next computerPlay() re-roots at the reply played. A pondered root selects
+ * by value instead of halving, so most of the work lands in the replies
+ * the opponent is likely to play.
+ * @note search is split into cn_SEARCH_BATCH iteration tasks, one chain per
+ * worker state; each task queues the next batch on the worker's own deque
+ * until the budget is spent, so a worker that falls idle steals a waiting
+ * batch and every core stays busy to the end of the budget.
+ * @note workers are started once with the engine and reused for every move,
+ * each keeps its working boards in its thread local ObjectPool.
+ */
+template <MapSize N>
+class MctsEngine {
+public:
+    /// @brief MctsEngine : constructor
+    /// @param seed - see setSeed()
+    /// @param threads - search threads, 0 selects ThreadPool::getDefaultSize().
+    /// @param memory_mb - search tree memory ceiling, see MctsTree.
+    explicit MctsEngine(const RandomSeed& seed = 0, const size_t& threads = 0, const size_t& memory_mb = cn_TREE_MEMORY_MB) :
+        m_pool(threads),
+        m_tree(memory_mb),
+        m_workers(m_pool.getSize()),
+        m_chains(m_pool.getSize()) {
+        this->setSeed(seed);
+    }
+
+    /// @brief setSeed : seeds every worker's generator from a single value.
+    /// @details worker seeds are drawn from seed with splitmix64, so workers
+    /// never share a sequence. With one thread and a playout budget a search
+    /// is reproducible; otherwise it varies with thread timing.
+    /// @param seed
+    void setSeed(RandomSeed seed) {
+        for (auto& worker : this->m_workers)
+            worker.random.seed(Random::splitMix(seed));
+    }
+
+    /// @brief setBudget : sets budget used by computerPlay(game, player).
+    /// @param budget
+    void setBudget(const SearchBudget& budget) { this->m_budget = budget; }
+
+    /// @brief computerPlay : searches position within engine budget and adds best move for player.
+    /// @param game - position, best move is played on return.
+    /// @param player - player to move.
+    /// @return Probability - position and estimated win probability of move played.
+    Probability computerPlay(HexGame<N>& game, const Player& player) {
+        return this->computerPlay(game, player, this->m_budget);
+    }
+
+    /// @brief computerPlay : searches position within budget and adds best move for player.
+    /// @param game - position, best move is played on return.
+    /// @param player - player to move.
+    /// @param budget
+    /// @return Probability - position and estimated win probability of move played.
+    Probability computerPlay(HexGame<N>& game, const Player& player, SearchBudget budget) {
+
+        if ((budget.time_ms <= 0) && (budget.playouts == 0))
+            budget.time_ms = cn_MOVE_TIME_MS;
+
+        this->stopPondering();
+        this->prepareTree(game, player, false);
+
+        const Clock::time_point start = Clock::now();
+        size_t rounds = 1;
+
+        while ((size_t(1) << rounds) < this->m_tree.getRootActive())
+            rounds++;
+
+        for (size_t round = 0; round < rounds; ++round) {
+            const Clock::time_point deadline = (budget.time_ms > 0) ?
+                        (start + std::chrono::milliseconds((static_cast<int64_t>(budget.time_ms) * (round + 1)) / rounds)) :
+                        Clock::time_point::max();
+
+            this->m_playouts_limited = (budget.playouts > 0);
+            this->m_playouts_left = ((budget.playouts * (round + 1)) / rounds) - ((budget.playouts * round) / rounds);
+
+            // proven root : remaining budget is not needed
+            if (this->m_tree.isRootSolved() == false) {
+                this->startSearch(&game, deadline);
+
+                // Await round completion
+                this->m_pool.wait();
+            }
+
+            // moves dropped earlier rank again if every kept move is lost
+            this->m_tree.reviveRootMoves();
+            const std::vector<CellId> ranked = this->rankRootMoves();
+
+            if (((round + 1) == rounds) || this->m_tree.isRootSolved()) {
+                const CellId best = ranked.front();
+                const Position position = Adjacency<N>::getPosition(best);
+                const float win_rate = (this->m_proofs[best] == NodeProof::WIN) ? 1.0f :
+                            (this->m_visits[best] > 0) ? (static_cast<float>(this->m_wins[best]) / this->m_visits[best]) : 0.0f;
+
+                game.addPlay(player, best);
+                return Probability(win_rate, position.getRow(), position.getCol());
+            }
+
+            this->m_tree.recycle();
+
+            // keep better half
+            Bitboard<N> keep;
+            for (size_t idx = 0; idx < ((ranked.size() + 1) / 2); ++idx)
+                keep.set(ranked[idx]);
+
+            this->m_tree.keepRootMoves(keep);
+        }
+
+        assert(false); // final round (or solved root) returns
+        return Probability(0.0f, 0, 0);
+    }
+
+    /// @brief ponder : starts searching position in the background, returns at once.
+    /// @details runs until stopPondering() (or computerPlay()), position is
+    /// copied so game may be changed once pondering has stopped.
+    /// @param game - position, opponent to move.
+    /// @param player - opponent.
+    void ponder(const HexGame<N>& game, const Player& player) {
+        this->stopPondering();
+
+        this->m_ponder_game = game;
+        this->prepareTree(this->m_ponder_game, player, true);
+        this->m_playouts_limited = false;
+        this->m_pondering = true;
+
+        this->startSearch(&this->m_ponder_game, Clock::time_point::max());
+    }
+
+    /// @brief stopPondering : stops background search, waits for running batches.
+    void stopPondering() {
+        if (this->m_pondering == false)
+            return;
+
+        this->m_stop = true;
+        this->m_pool.wait();
+        this->m_stop = false;
+        this->m_pondering = false;
+    }
+
+    ~MctsEngine() {
+        this->stopPondering();
+    }
+private:
+    /// @brief prepareTree : re-roots tree at game when it continues last search, else resets it.
+    /// @details root is expanded, last searched position becomes game. A
+    /// pondered root keeps every move of a symmetric position, the reply
+    /// played next is then always found by advance(), and selects by value
+    /// rather than halving (see MctsTree::setRootHalving()).
+    /// @param game, player - player to move.
+    /// @param pondering
+    void prepareTree(const HexGame<N>& game, const Player& player, const bool& pondering) {
+        if ((this->isContinuation(game) == false) || (this->m_tree.advance(game, this->m_root_ply, player) == false))
+            this->m_tree.reset(player);
+        this->m_tree.recycle();
+        this->m_tree.setSymmetryPruning(pondering == false);
+        this->m_tree.setRootHalving(pondering == false);
+        this->m_tree.run(&game, 0, this->m_workers[0]);
+
+        this->m_root_ply = game.getPly();
+        this->m_root_hash = game.hash();
+        this->m_searched = true;
+    }
+
+    /// @brief SearchChain : one worker's chain of batches, the only state a queued batch refers to.
+    /// @details batches capture a single pointer, which std::function stores
+    /// in place, so queueing a batch does not allocate.
+    struct SearchChain {
+        MctsEngine * engine;
+        SearchWorker<N> * worker;
+        const HexGame<N> * root;
+        Clock::time_point deadline;
+    };
+
+    /// @brief startSearch : queues the first batch of every worker's chain.
+    /// @param root, deadline
+    void startSearch(const HexGame<N> * root, const Clock::time_point deadline) {
+        this->m_chains_running = this->m_chains.size();
+
+        for (size_t idx = 0; idx < this->m_chains.size(); ++idx) {
+            this->m_chains[idx] = SearchChain{ this, &this->m_workers[idx], root, deadline };
+            this->searchBatch(&this->m_chains[idx]);
+        }
+    }
+
+    /// @brief searchBatch : queues one batch for chain, which queues the next until budget is spent (or stopped).
+    /// @details a chain also ends once the tree needs recycling; the last
+    /// chain to end then recycles (no other batch is running) and, if the
+    /// search is not over, starts every chain again.
+    /// @param chain
+    void searchBatch(SearchChain * chain) {
+        this->m_pool.submit([chain]() {
+            MctsEngine& engine = *chain->engine;
+            const size_t iterations = engine.claimPlayouts();
+            engine.m_tree.run(chain->root, iterations, *chain->worker);
+
+            const bool more = (iterations == cn_SEARCH_BATCH) && (engine.m_stop == false) &&
+                    (engine.m_tree.isRootSolved() == false) && (Clock::now() < chain->deadline);
+
+            if (more && (engine.m_tree.needsRecycle() == false)) {
+                engine.searchBatch(chain);
+            } else if ((--engine.m_chains_running == 0) && more) {
+                engine.m_tree.recycle();
+                engine.startSearch(chain->root, chain->deadline);
+            }
+        });
+    }
+
+    /// @brief isContinuation : returns true if game continues from last searched position.
+    /// @param game
+    /// @return true / false
+    bool isContinuation(const HexGame<N>& game) const {
+        if ((this->m_searched == false) || (game.getPly() < this->m_root_ply))
+            return false;
+
+        auto board = ObjectPool<HexGame<N>>::local().acquire();
+        *board = game;
+        board->undoTo(this->m_root_ply);
+        return (board->hash() == this->m_root_hash);
+    }
+
+    /// @brief rankRootMoves : returns active root moves, and any proven win, best first.
+    /// @details proven wins rank first and proven losses last, other moves,
+    /// and losses among themselves, by mean with unvisited moves after
+    /// visited ones, so a lost root still plays its longest resistance.
+    /// m_visits, m_wins and m_proofs hold the root statistics, indexed by cell id.
+    /// @return std::vector<CellId>
+    std::vector<CellId> rankRootMoves() {
+        std::vector<CellId> ranked;
+
+        const NodeStore& nodes = this->m_tree.getNodes();
+
+        for (NodeIndex idx = nodes.getFirstChild(0); idx < nodes.getChildEnd(0); ++idx) {
+            const CellId move = nodes.getMove(idx);
+
+            if (this->m_tree.isRootActive(move) || (nodes.getProof(idx) == NodeProof::WIN)) {
+                this->m_visits[move] = nodes.getVisits(idx);
+                this->m_wins[move] = nodes.getWins(idx);
+                this->m_proofs[move] = nodes.getProof(idx);
+                ranked.push_back(move);
+            }
+        }
+
+        auto mean = [this](const CellId& id)->float {
+            const float value = (this->m_visits[id] > 0) ? (static_cast<float>(this->m_wins[id]) / this->m_visits[id]) : -1.0f;
+
+            if (this->m_proofs[id] == NodeProof::WIN)
+                return 2.0f;
+            return (this->m_proofs[id] == NodeProof::LOSS) ? (value - 3.0f) : value; // losses last, longest resistance first
+        };
+
+        std::stable_sort(ranked.begin(), ranked.end(),
+                [&mean](const CellId& lhs, const CellId& rhs) { return (mean(lhs) > mean(rhs)); });
+        return ranked;
+    }
+
+    /// @brief claimPlayouts : takes up to cn_SEARCH_BATCH iterations from playout budget.
+    /// @return size_t - iterations granted, below cn_SEARCH_BATCH once budget is spent.
+    size_t claimPlayouts() {
+        if (this->m_playouts_limited == false)
+            return cn_SEARCH_BATCH;
+
+        PlayoutCount left = this->m_playouts_left.load();
+        PlayoutCount granted = 0;
+
+        do {
+            granted = std::min<PlayoutCount>(left, cn_SEARCH_BATCH);
+        } while (this->m_playouts_left.compare_exchange_weak(left, left - granted) == false);
+
+        return static_cast<size_t>(granted);
+    }
+
+    ThreadPool m_pool;                // search workers, live as long as the engine
+    MctsTree<N> m_tree;               // shared by all workers, kept between moves
+    std::vector<SearchWorker<N>> m_workers; // one per pool worker
+    std::vector<SearchChain> m_chains;      // one per worker, referred to by queued batches
+    std::atomic<size_t> m_chains_running{ 0 }; // chains not yet ended, see searchBatch()
+    SearchBudget m_budget;
+    std::array<VisitCount, Adjacency<N>::cn_CELL_COUNT> m_visits; // root statistics, by cell id
+    std::array<VisitCount, Adjacency<N>::cn_CELL_COUNT> m_wins;
+    std::array<NodeProof, Adjacency<N>::cn_CELL_COUNT> m_proofs;
+    bool m_searched = false;          // tree holds a search of position below
+    PlayCount m_root_ply = 0;         // ply and hash of last searched position
+    HashKey m_root_hash = 0;
+    bool m_pondering = false;
+    std::atomic<bool> m_stop{ false }; // ends pondering batches
+    HexGame<N> m_ponder_game;         // position searched while pondering
+    bool m_playouts_limited = false;  // current search has a playout budget
+    std::atomic<PlayoutCount> m_playouts_left{ 0 };
+};
+
+#endif
+    // MCTS_H
+
+/****************************************end of file****************************************/
@@ -0,0 +1,229 @@
+/**
+ * @name node_store.h
+ * @brief provides fixed capacity, structure of arrays storage for search tree nodes.
+ */
+#ifndef NODE_STORE_H
+#define NODE_STORE_H
+
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bitboard.h"
+
+using VisitCount = uint32_t;
+using NodeIndex  = uint32_t; // arena position, children of a node are a contiguous range
+
+/// @brief class : NodeState enumeration : expansion state of a node
+enum class NodeState : uint8_t { LEAF, EXPANDING, EXPANDED, FULL };
+
+/// @brief class : NodeProof enumeration : game theoretic value for the player who played move
+enum class NodeProof : uint8_t { UNKNOWN, WIN, LOSS };
+
+/**
+ * @brief class NodeStore : search tree nodes held in one arena, one array per field.
+ *
+ * @details a node is reached by playing move, its children are the range
+ * [first child, first child + child count). Nodes are handed out in blocks
+ * by allocate(), a single atomic add, and only returned all at once by
+ * clear(); the arrays are allocated once at construction (capacity fixed),
+ * their pages are only touched as nodes are used. Statistics live in
+ * separate arrays so scanning a block of children reads contiguous memory.
+ *
+ * @note wins are counted for the player who played move, i.e. the player
+ * choosing between this node and its siblings. amaf_ (all moves as first)
+ * statistics count every iteration through the parent in which move was
+ * played by the same player at any later point.
+ * @note a proof, once set, is final: it holds however the node's children
+ * are later dropped or recycled, and is copied along with the node.
+ * @note statistics are updated by every search thread without locks
+ * (relaxed atomics). First child and child count are written once by the
+ * thread that wins claim(), and published to the others by publish().
+ */
+class NodeStore {
+public:
+    /// @brief cn_NODE_BYTES : storage per node, for sizing against a memory limit
+    static constexpr size_t cn_NODE_BYTES = sizeof(CellId) + sizeof(uint16_t) + sizeof(NodeIndex) +
+            sizeof(NodeState) + sizeof(NodeProof) + (4 * sizeof(VisitCount));
+
+    /// @brief NodeStore : constructor, allocates arrays for capacity nodes.
+    /// @param capacity
+    explicit NodeStore(const NodeIndex& capacity) :
+        m_capacity(capacity),
+        m_size(0),
+        m_move(new CellId[capacity]),
+        m_child_count(new uint16_t[capacity]),
+        m_first_child(new NodeIndex[capacity]),
+        m_state(new std::atomic<NodeState>[capacity]),
+        m_proof(new std::atomic<NodeProof>[capacity]),
+        m_visits(new std::atomic<VisitCount>[capacity]),
+        m_wins(new std::atomic<VisitCount>[capacity]),
+        m_amaf_visits(new std::atomic<VisitCount>[capacity]),
+        m_amaf_wins(new std::atomic<VisitCount>[capacity]) {
+    }
+
+    NodeStore(const NodeStore&) = delete;
+    NodeStore& operator=(const NodeStore&) = delete;
+
+    /// @brief getCapacity : returns maximum number of nodes.
+    NodeIndex getCapacity() const { return m_capacity; }
+
+    /// @brief getSize : returns nodes in use.
+    NodeIndex getSize() const { return std::min(m_size.load(std::memory_order_relaxed), m_capacity); }
+
+    /// @brief clear : releases every node (no search may be running).
+    void clear() { m_size = 0; }
+
+    /// @brief allocate : reserves count consecutive nodes.
+    /// @param count
+    /// @return NodeIndex - first node, getCapacity() if store is full.
+    NodeIndex allocate(const NodeIndex& count) {
+        if ((m_size.load(std::memory_order_relaxed) + count) > m_capacity)
+            return m_capacity;
+
+        const NodeIndex first = m_size.fetch_add(count, std::memory_order_relaxed);
+        return ((first + count) <= m_capacity) ? first : m_capacity; // lost a race for the last block
+    }
+
+    /// @brief init : sets node as an unvisited leaf for move.
+    /// @param idx, move
+    void init(const NodeIndex& idx, const CellId& move) {
+        m_move[idx] = move;
+        m_child_count[idx] = 0;
+        m_first_child[idx] = 0;
+        m_state[idx].store(NodeState::LEAF, std::memory_order_relaxed);
+        m_proof[idx].store(NodeProof::UNKNOWN, std::memory_order_relaxed);
+        m_visits[idx].store(0, std::memory_order_relaxed);
+        m_wins[idx].store(0, std::memory_order_relaxed);
+        m_amaf_visits[idx].store(0, std::memory_order_relaxed);
+        m_amaf_wins[idx].store(0, std::memory_order_relaxed);
+    }
+
+    /// @brief setPrior : starts AMAF statistics of a new node at prior knowledge.
+    /// @details acts as visits earlier play outs, outweighed as real ones arrive.
+    /// @param idx, visits, wins
+    void setPrior(const NodeIndex& idx, const VisitCount& visits, const VisitCount& wins) {
+        m_amaf_visits[idx].store(visits, std::memory_order_relaxed);
+        m_amaf_wins[idx].store(wins, std::memory_order_relaxed);
+    }
+
+    /// @brief copy : copies node from another store (no search may be running).
+    /// @details copied node keeps its children range and state, callers fix both.
+    /// @param from, src - source store and node
+    /// @param dst - node in this store
+    void copy(const NodeStore& from, const NodeIndex& src, const NodeIndex& dst) {
+        m_move[dst] = from.m_move[src];
+        m_child_count[dst] = from.m_child_count[src];
+        m_first_child[dst] = from.m_first_child[src];
+        m_state[dst].store(from.m_state[src].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        m_proof[dst].store(from.getProof(src), std::memory_order_relaxed);
+        m_visits[dst].store(from.getVisits(src), std::memory_order_relaxed);
+        m_wins[dst].store(from.getWins(src), std::memory_order_relaxed);
+        m_amaf_visits[dst].store(from.getAmafVisits(src), std::memory_order_relaxed);
+        m_amaf_wins[dst].store(from.getAmafWins(src), std::memory_order_relaxed);
+    }
+
+    /// @brief setSize : sets nodes in use after nodes were copied in (no search may be running).
+    void setSize(const NodeIndex& size) { m_size = size; }
+
+    /// @brief swap : exchanges contents with another store of the same capacity.
+    void swap(NodeStore& other) {
+        std::swap(m_capacity, other.m_capacity);
+        const NodeIndex size = m_size;
+        m_size = other.m_size.load();
+        other.m_size = size;
+        std::swap(m_move, other.m_move);
+        std::swap(m_child_count, other.m_child_count);
+        std::swap(m_first_child, other.m_first_child);
+        std::swap(m_state, other.m_state);
+        std::swap(m_proof, other.m_proof);
+        std::swap(m_visits, other.m_visits);
+        std::swap(m_wins, other.m_wins);
+        std::swap(m_amaf_visits, other.m_amaf_visits);
+        std::swap(m_amaf_wins, other.m_amaf_wins);
+    }
+
+    // structure
+    CellId getMove(const NodeIndex& idx) const { return m_move[idx]; }
+    NodeIndex getFirstChild(const NodeIndex& idx) const { return m_first_child[idx]; }
+    NodeIndex getChildEnd(const NodeIndex& idx) const { return m_first_child[idx] + m_child_count[idx]; }
+    uint16_t getChildCount(const NodeIndex& idx) const { return m_child_count[idx]; }
+
+    /// @brief isExpanded : returns true once children are published.
+    bool isExpanded(const NodeIndex& idx) const {
+        return (m_state[idx].load(std::memory_order_acquire) == NodeState::EXPANDED);
+    }
+
+    /// @brief claim : LEAF -> EXPANDING, returns true if caller now expands node.
+    bool claim(const NodeIndex& idx) {
+        NodeState expected = NodeState::LEAF;
+        return m_state[idx].compare_exchange_strong(expected, NodeState::EXPANDING, std::memory_order_acquire);
+    }
+
+    /// @brief publish : sets children of claimed node and makes them visible (EXPANDED).
+    void publish(const NodeIndex& idx, const NodeIndex& first, const uint16_t& count) {
+        m_first_child[idx] = first;
+        m_child_count[idx] = count;
+        m_state[idx].store(NodeState::EXPANDED, std::memory_order_release);
+    }
+
+    /// @brief markFull : claimed node could not be expanded, it stays a leaf.
+    void markFull(const NodeIndex& idx) {
+        m_state[idx].store(NodeState::FULL, std::memory_order_release);
+    }
+
+    /// @brief setLeaf : drops children of node, it may be expanded again (no search may be running).
+    void setLeaf(const NodeIndex& idx) {
+        m_first_child[idx] = 0;
+        m_child_count[idx] = 0;
+        m_state[idx].store(NodeState::LEAF, std::memory_order_relaxed);
+    }
+
+    /// @brief getProof : returns proven value for player who played move.
+    NodeProof getProof(const NodeIndex& idx) const { return m_proof[idx].load(std::memory_order_relaxed); }
+
+    /// @brief isProven : returns true if node's value is known.
+    bool isProven(const NodeIndex& idx) const { return (this->getProof(idx) != NodeProof::UNKNOWN); }
+
+    /// @brief setProof : records proven value, set once per node.
+    void setProof(const NodeIndex& idx, const NodeProof& proof) { m_proof[idx].store(proof, std::memory_order_relaxed); }
+
+    // statistics (relaxed)
+    VisitCount getVisits(const NodeIndex& idx) const { return m_visits[idx].load(std::memory_order_relaxed); }
+    VisitCount getWins(const NodeIndex& idx) const { return m_wins[idx].load(std::memory_order_relaxed); }
+    VisitCount getAmafVisits(const NodeIndex& idx) const { return m_amaf_visits[idx].load(std::memory_order_relaxed); }
+    VisitCount getAmafWins(const NodeIndex& idx) const { return m_amaf_wins[idx].load(std::memory_order_relaxed); }
+
+    void addVisits(const NodeIndex& idx, const VisitCount& count) { m_visits[idx].fetch_add(count, std::memory_order_relaxed); }
+    void subVisits(const NodeIndex& idx, const VisitCount& count) { m_visits[idx].fetch_sub(count, std::memory_order_relaxed); }
+    void addWin(const NodeIndex& idx) { m_wins[idx].fetch_add(1, std::memory_order_relaxed); }
+
+    /// @brief addAmaf : adds AMAF visit, and win if won.
+    void addAmaf(const NodeIndex& idx, const bool& won) {
+        m_amaf_visits[idx].fetch_add(1, std::memory_order_relaxed);
+        if (won)
+            m_amaf_wins[idx].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ~NodeStore() = default;
+private:
+    NodeIndex m_capacity;
+    std::atomic<NodeIndex> m_size; // next free node (may overshoot capacity when full)
+
+    std::unique_ptr<CellId[]>                  m_move;        // cell played to reach node
+    std::unique_ptr<uint16_t[]>                m_child_count;
+    std::unique_ptr<NodeIndex[]>               m_first_child;
+    std::unique_ptr<std::atomic<NodeState>[]>  m_state;
+    std::unique_ptr<std::atomic<NodeProof>[]>  m_proof;
+    std::unique_ptr<std::atomic<VisitCount>[]> m_visits;
+    std::unique_ptr<std::atomic<VisitCount>[]> m_wins;
+    std::unique_ptr<std::atomic<VisitCount>[]> m_amaf_visits;
+    std::unique_ptr<std::atomic<VisitCount>[]> m_amaf_wins;
+};
+
+#endif
+    // NODE_STORE_H
+
+/****************************************end of file****************************************/
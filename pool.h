@@ -0,0 +1,86 @@
+/**
+ * @name pool.h
+ * @brief provides per thread object pool for reusable search buffers.
+ */
+#ifndef POOL_H
+#define POOL_H
+
+#include <vector>
+#include <memory>
+#include <stddef.h>
+
+/**
+ * @brief class ObjectPool : per thread free list of reusable objects.
+ * @tparam T - default constructible, copy assignable object (e.g. HexGame<N>)
+ * @tparam ChunkSize - objects allocated together when the pool runs dry.
+ *
+ * @details objects are allocated in chunks (arena style) and never freed
+ * until the owning thread exits; released objects are handed out again
+ * without being destroyed, callers overwrite them by assignment. After
+ * warm-up acquire() / release() perform no heap allocation.
+ *
+ * @note use local() for the calling thread's pool, no locking is required.
+ * An object may be used by any thread, but must be released to the pool it
+ * was acquired from (the Handle deleter does this).
+ */
+template <class T, size_t ChunkSize = 16>
+class ObjectPool {
+public:
+    /// @brief Releaser : Handle deleter, returns object to its pool.
+    struct Releaser {
+        ObjectPool * pool;
+        void operator()(T * object) const { pool->release(object); }
+    };
+
+    using Handle = std::unique_ptr<T, Releaser>;
+
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /// @brief local : returns calling thread's pool.
+    /// @return ObjectPool&
+    static ObjectPool& local() {
+        static thread_local ObjectPool pool;
+        return pool;
+    }
+
+    /// @brief acquire : returns object from free list, growing pool if empty.
+    /// @return Handle - object returned to pool when handle is destroyed.
+    Handle acquire() {
+        if (m_free.empty())
+            this->grow();
+
+        T * object = m_free.back();
+        m_free.pop_back();
+        return Handle(object, Releaser{ this });
+    }
+
+    /// @brief release : returns object to free list.
+    /// @param object
+    void release(T * object) {
+        m_free.push_back(object);
+    }
+
+    /// @brief getCapacity : returns number of objects owned by pool.
+    size_t getCapacity() const { return m_chunks.size() * ChunkSize; }
+
+    ~ObjectPool() = default;
+private:
+    std::vector<std::unique_ptr<T[]>> m_chunks; // owned storage
+    std::vector<T*> m_free;                     // objects available for acquire()
+
+    /// @brief grow : allocates a new chunk and adds it to the free list.
+    void grow() {
+        m_chunks.emplace_back(new T[ChunkSize]);
+        m_free.reserve(this->getCapacity());
+
+        for (size_t idx = 0; idx < ChunkSize; ++idx)
+            m_free.push_back(&m_chunks.back()[idx]);
+    }
+};
+
+#endif
+    // POOL_H
+
+/****************************************end of file****************************************/
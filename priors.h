@@ -0,0 +1,120 @@
+/**
+ * @name priors.h
+ * @brief provides cheap move knowledge used to order and seed new search tree children.
+ */
+#ifndef PRIORS_H
+#define PRIORS_H
+
+#include <algorithm>
+#include <stdint.h>
+
+#include "hex_game.h"
+
+// Prior constants, values are the mover's expected win rate
+static const float   cn_PRIOR_NEUTRAL     = 0.5f;   // cell with no feature
+static const float   cn_PRIOR_SAVE_BRIDGE = 0.35f;  // answers an intrusion into own bridge
+static const float   cn_PRIOR_MAKE_BRIDGE = 0.1f;   // forms a bridge with an own stone
+static const float   cn_PRIOR_LAST_MOVE   = 0.1f;   // touches the opponent's last move
+static const float   cn_PRIOR_EDGE        = 0.1f;   // spread between own edge row and board interior
+static const uint8_t cn_PRIOR_EDGE_DEPTH  = 3;      // rows from own edge counted as interior
+
+/**
+ * @brief class MovePriors : scores free cells for the player to move, from the board's adjacency.
+ * @tparam N - board size
+ *
+ * @details the score of a cell starts at cn_PRIOR_NEUTRAL and adds:
+ *     bridge save  - cell is the free carrier of an own bridge whose other
+ *                    carrier the opponent has just taken.
+ *     bridge make  - cell is a bridge partner of an own stone, both carriers free.
+ *     last move    - cell neighbours the opponent's last stone.
+ *     edge         - rises from -cn_PRIOR_EDGE / 2 on the player's own edge
+ *                    rows to +cn_PRIOR_EDGE / 2 cn_PRIOR_EDGE_DEPTH rows in.
+ *
+ * @note bridge saves and last move neighbours are found once per position
+ * by the constructor, get() is then a few table lookups per cell.
+ */
+template <MapSize N>
+class MovePriors {
+public:
+    /// @brief MovePriors : constructor, finds features of the last move.
+    /// @param game - position
+    /// @param player - player to move
+    MovePriors(const HexGame<N>& game, const Player& player) :
+        m_game(game),
+        m_colour(HexGame<N>::convertPlayer(player)) {
+
+        if (game.getPly() == 0)
+            return;
+
+        const Adjacency<N>& adjacency = Adjacency<N>::get();
+        const Bitboard<N>& own = game.getStones(this->m_colour);
+        const CellId last = game.getMove(game.getPly() - 1);
+        const CellId * neighbours = adjacency.getNeighbours(last);
+
+        for (uint8_t idx = 0; idx < adjacency.getNeighbourCount(last); ++idx) {
+            const CellId stone = neighbours[idx];
+            this->m_near.set(stone);
+
+            if (own.test(stone) == false)
+                continue;
+
+            // own bridges of stone that last intruded into
+            const Bridge * bridges = adjacency.getBridges(stone);
+            for (uint8_t bridge = 0; bridge < adjacency.getBridgeCount(stone); ++bridge) {
+                const Bridge& candidate = bridges[bridge];
+
+                if (own.test(candidate.partner) == false)
+                    continue;
+                if (candidate.carriers[0] == last)
+                    this->m_saves.set(candidate.carriers[1]);
+                else if (candidate.carriers[1] == last)
+                    this->m_saves.set(candidate.carriers[0]);
+            }
+        }
+    }
+
+    /// @brief get : returns prior of free cell.
+    /// @param id
+    /// @return float - in (0, 1)
+    float get(const CellId& id) const {
+        const Adjacency<N>& adjacency = Adjacency<N>::get();
+        const Bitboard<N>& own = this->m_game.getStones(this->m_colour);
+        float prior = cn_PRIOR_NEUTRAL;
+
+        if (this->m_saves.test(id) && (this->m_game.getColour(id) == NodeColour::WHITE))
+            prior += cn_PRIOR_SAVE_BRIDGE;
+
+        const Bridge * bridges = adjacency.getBridges(id);
+        for (uint8_t idx = 0; idx < adjacency.getBridgeCount(id); ++idx) {
+            if (own.test(bridges[idx].partner) &&
+                    (this->m_game.getColour(bridges[idx].carriers[0]) == NodeColour::WHITE) &&
+                    (this->m_game.getColour(bridges[idx].carriers[1]) == NodeColour::WHITE)) {
+                prior += cn_PRIOR_MAKE_BRIDGE;
+                break;
+            }
+        }
+
+        if (this->m_near.test(id))
+            prior += cn_PRIOR_LAST_MOVE;
+
+        const Position position = Adjacency<N>::getPosition(id);
+        const Coordinate line = (this->m_colour == NodeColour::GREEN) ? position.getCol() : position.getRow();
+        const uint8_t depth = std::min<uint8_t>(std::min<uint8_t>(line, N - 1 - line), cn_PRIOR_EDGE_DEPTH);
+
+        prior += cn_PRIOR_EDGE * ((static_cast<float>(depth) / cn_PRIOR_EDGE_DEPTH) - 0.5f);
+
+        return std::min(std::max(prior, 0.05f), 0.95f);
+    }
+
+    ~MovePriors() = default;
+private:
+    const HexGame<N>& m_game;
+    NodeColour m_colour;   // player to move
+    Bitboard<N> m_saves;   // carriers answering the last move's bridge intrusions
+    Bitboard<N> m_near;    // neighbours of the last move
+};
+
+#endif
+    // PRIORS_H
+
+/****************************************end of file****************************************/
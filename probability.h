@@ -8,7 +8,6 @@
 #include "position.h"
 
 using ProbabilityValue = float; // floating point used for probability value (percentage of 1.0).
-using PlayCount = int; // play count (strong type)
 
 /**
  * @brief Probability class. Stores position and probability value of player winning.
@@ -0,0 +1,87 @@
+/**
+ * @name random.h
+ * @brief provides small, fast pseudo random generator for play outs.
+ */
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+using RandomSeed = uint64_t;
+
+/**
+ * @brief class Random : xoshiro256** generator, one instance per search thread.
+ *
+ * @details replaces the C library rand(), whose single global state is
+ * shared (and possibly locked) between threads and whose low bits are weak.
+ * Each owner seeds its own instance, so a fixed seed reproduces a search
+ * exactly on the same thread count.
+ *
+ * @note seed() expands a single 64 bit value into the 256 bit state with
+ * splitmix64, any seed (including 0) gives a valid state. Not for
+ * cryptographic use.
+ */
+class Random {
+public:
+    /// @brief Random : constructor
+    /// @param seed
+    explicit Random(const RandomSeed& seed = 0) {
+        this->seed(seed);
+    }
+
+    /// @brief seed : resets generator state from seed.
+    /// @param seed
+    void seed(RandomSeed seed) {
+        for (auto& word : m_state)
+            word = splitMix(seed);
+    }
+
+    /// @brief next : returns next 64 random bits.
+    /// @return uint64_t
+    uint64_t next() {
+        const uint64_t result = rotate(m_state[1] * 5, 7) * 9;
+        const uint64_t shifted = m_state[1] << 17;
+
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= shifted;
+        m_state[3] = rotate(m_state[3], 45);
+
+        return result;
+    }
+
+    /// @brief below : returns value in [0, bound).
+    /// @details multiply-shift on the high 32 bits, no division or modulo
+    /// (bias is below bound / 2^32, negligible for board sized bounds).
+    /// @param bound - greater than 0
+    /// @return uint32_t
+    uint32_t below(const uint32_t& bound) {
+        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    /// @brief splitMix : splitmix64 step, also used to derive per thread seeds.
+    /// @param state - advanced by call
+    /// @return uint64_t
+    static uint64_t splitMix(RandomSeed& state) {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    ~Random() = default;
+private:
+    uint64_t m_state[4];
+
+    /// @brief rotate : rotate left
+    static uint64_t rotate(const uint64_t& value, const int& count) {
+        return (value << count) | (value >> (64 - count));
+    }
+};
+
+#endif
+    // RANDOM_H
+
+/****************************************end of file****************************************/
@@ -0,0 +1,190 @@
+/**
+ * @name thread_pool.h
+ * @brief provides persistent work stealing workers for the computer player's search.
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <stddef.h>
+
+/**
+ * @brief class ThreadPool : fixed set of work stealing workers running submitted tasks.
+ *
+ * @details workers are started once by the constructor and live until the
+ * pool is destroyed, so submitting work costs a queue push rather than a
+ * thread start. Each worker owns a deque: tasks submitted by a worker go to
+ * the back of its own deque and are popped from the back (most recent
+ * first), tasks submitted from outside are dealt round robin. A worker whose
+ * deque is empty steals the oldest task from the front of another worker's
+ * deque, so no worker idles while any task is queued. wait() blocks until
+ * every submitted task, including tasks submitted by tasks, has finished.
+ *
+ * @note deques are guarded by their own mutex (uncontended unless a steal
+ * is in progress), the pool wide mutex is only taken to sleep and wake.
+ * A task must not call wait() on its own pool.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /// @brief ThreadPool : constructor, starts workers.
+    /// @param count - number of workers, 0 selects getDefaultSize().
+    explicit ThreadPool(size_t count = 0) :
+        m_queued(0),
+        m_pending(0),
+        m_next(0),
+        m_stopping(false) {
+
+        if (count == 0)
+            count = getDefaultSize();
+
+        for (size_t idx = 0; idx < count; ++idx)
+            m_queues.emplace_back(new WorkQueue());
+
+        m_workers.reserve(count);
+        for (size_t idx = 0; idx < count; ++idx)
+            m_workers.emplace_back(&ThreadPool::work, this, idx);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief getDefaultSize : returns hardware thread count (1 if unknown).
+    /// @return size_t
+    static size_t getDefaultSize() {
+        const size_t count = std::thread::hardware_concurrency();
+        return (count > 0) ? count : 1;
+    }
+
+    /// @brief getSize : returns number of workers.
+    size_t getSize() const { return m_workers.size(); }
+
+    /// @brief submit : queues task, on own deque when called from a worker.
+    /// @param task
+    void submit(Task task) {
+        const size_t owner = (getWorker().pool == this) ?
+                    getWorker().index : (m_next.fetch_add(1) % m_queues.size());
+
+        // counted before the push, so m_queued never drops below the tasks held.
+        m_pending++;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queued++;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_queues[owner]->mutex);
+            m_queues[owner]->tasks.push_back(std::move(task));
+        }
+        m_task_ready.notify_one();
+    }
+
+    /// @brief wait : blocks until every submitted task has completed.
+    void wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_all_done.wait(lock, [this]() { return (m_pending == 0); });
+    }
+
+    /// @brief ~ThreadPool : finishes queued tasks, then joins workers.
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_task_ready.notify_all();
+
+        for (auto& worker : m_workers)
+            worker.join();
+    }
+private:
+    /// @brief WorkQueue : one worker's deque.
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /// @brief WorkerId : identifies pool and deque of calling thread.
+    struct WorkerId {
+        const ThreadPool * pool;
+        size_t index;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues; // one per worker
+    std::vector<std::thread> m_workers;
+    std::atomic<size_t> m_queued;       // tasks waiting in any deque
+    std::atomic<size_t> m_pending;      // queued plus running tasks
+    std::atomic<size_t> m_next;         // round robin target for outside submits
+    bool m_stopping;                    // guarded by m_mutex
+    std::mutex m_mutex;
+    std::condition_variable m_task_ready;
+    std::condition_variable m_all_done;
+
+    /// @brief getWorker : returns calling thread's worker id ({nullptr, 0} off pool).
+    static WorkerId& getWorker() {
+        static thread_local WorkerId worker{ nullptr, 0 };
+        return worker;
+    }
+
+    /// @brief take : pops own deque from back, else steals from front of others.
+    /// @param index - calling worker
+    /// @param task - set on success
+    /// @return true if task taken
+    bool take(const size_t& index, Task& task) {
+        for (size_t offset = 0; offset < m_queues.size(); ++offset) {
+            WorkQueue& queue = *m_queues[(index + offset) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+
+            if (queue.tasks.empty())
+                continue;
+
+            if (offset == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            m_queued--;
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief work : worker loop, runs tasks until pool is stopping and all deques are empty.
+    /// @param index - worker's deque
+    void work(const size_t index) {
+        getWorker() = WorkerId{ this, index };
+
+        while (true) {
+            Task task;
+
+            if (this->take(index, task) == false) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_task_ready.wait(lock, [this]() { return (m_stopping || (m_queued > 0)); });
+
+                if (m_queued == 0)
+                    return; // stopping
+                continue;
+            }
+
+            task();
+
+            if (--m_pending == 0) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_all_done.notify_all();
+            }
+        }
+    }
+};
+
+#endif
+    // THREAD_POOL_H
+
+/****************************************end of file****************************************/
@@ -0,0 +1,148 @@
+/**
+ * @name transposition_table.h
+ * @brief provides lock free, fixed size table of search statistics keyed by position hash.
+ */
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <memory>
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "zobrist.h"
+#include "node_store.h"
+
+/**
+ * @brief class TranspositionTable : visits and wins per position, shared by every search thread.
+ *
+ * @details positions reached by different move orders share one entry, so a
+ * transposed line is credited with every play out through the position, not
+ * only those through one path. An entry holds the position hash and its
+ * statistics packed in a single 64 bit word (visits high, wins low), so one
+ * fetch_add records a result and one load reads a consistent pair.
+ * @details entries are grouped in buckets of cn_TABLE_BUCKET, a position may
+ * sit in any slot of the bucket selected by its hash. A new position takes
+ * an empty slot, or replaces the least visited one once the bucket is full,
+ * so memory stays fixed however long the table is used.
+ *
+ * @note lock free: slots are claimed with a compare exchange on the key.
+ * A thread updating a slot as it is replaced may credit one result to the
+ * new position, and a lookup racing a replacement is rejected by a second
+ * key check; both only blur statistics, never corrupt the table.
+ * @note wins count for the player who made the last move into the position,
+ * which is fixed by the position (stone count parity). Hash 0 (empty board)
+ * is never stored.
+ */
+class TranspositionTable {
+public:
+    static constexpr size_t cn_ENTRY_BYTES = 2 * sizeof(uint64_t);
+
+    /// @brief TranspositionTable : constructor, allocates and clears entries.
+    /// @param entries - rounded down to a power of two, at least one bucket.
+    explicit TranspositionTable(const size_t& entries) :
+        m_capacity(cn_TABLE_BUCKET) {
+
+        while ((m_capacity * 2) <= entries)
+            m_capacity *= 2;
+
+        m_keys.reset(new std::atomic<HashKey>[m_capacity]);
+        m_stats.reset(new std::atomic<uint64_t>[m_capacity]);
+        this->clear();
+    }
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    /// @brief getCapacity : returns number of entries.
+    size_t getCapacity() const { return m_capacity; }
+
+    /// @brief clear : empties every entry (no search may be running).
+    void clear() {
+        for (size_t idx = 0; idx < m_capacity; ++idx) {
+            m_keys[idx].store(0, std::memory_order_relaxed);
+            m_stats[idx].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief find : looks up statistics of position.
+    /// @param key - position hash
+    /// @param visits, wins - set when found
+    /// @return true if found
+    bool find(const HashKey& key, VisitCount& visits, VisitCount& wins) const {
+        const size_t first = this->getBucket(key);
+
+        for (size_t idx = first; idx < (first + cn_TABLE_BUCKET); ++idx) {
+            if (m_keys[idx].load(std::memory_order_acquire) != key)
+                continue;
+
+            const uint64_t stats = m_stats[idx].load(std::memory_order_relaxed);
+
+            if (m_keys[idx].load(std::memory_order_relaxed) != key)
+                return false; // replaced while reading
+            visits = static_cast<VisitCount>(stats >> 32);
+            wins = static_cast<VisitCount>(stats);
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief update : records one play out result through position, adding it if absent.
+    /// @param key - position hash
+    /// @param won - true if player who moved into position won.
+    void update(const HashKey& key, const bool& won) {
+        const uint64_t result = (uint64_t(1) << 32) | (won ? 1 : 0);
+        const size_t first = this->getBucket(key);
+
+        if (key == 0)
+            return;
+
+        size_t least = first;
+        uint64_t least_stats = ~uint64_t(0);
+
+        for (size_t idx = first; idx < (first + cn_TABLE_BUCKET); ++idx) {
+            HashKey current = m_keys[idx].load(std::memory_order_relaxed);
+
+            if ((current == 0) &&
+                    (m_keys[idx].compare_exchange_strong(current, key, std::memory_order_acq_rel) ||
+                     (current == key))) {
+                m_stats[idx].fetch_add(result, std::memory_order_relaxed);
+                return; // claimed empty slot, or another thread just claimed it for key
+            }
+
+            if (current == key) {
+                m_stats[idx].fetch_add(result, std::memory_order_relaxed);
+                return;
+            }
+
+            const uint64_t stats = m_stats[idx].load(std::memory_order_relaxed);
+            if (stats < least_stats) {
+                least_stats = stats;
+                least = idx;
+            }
+        }
+
+        // bucket full: replace least visited position
+        HashKey replaced = m_keys[least].load(std::memory_order_relaxed);
+        if ((replaced != key) && m_keys[least].compare_exchange_strong(replaced, key, std::memory_order_acq_rel))
+            m_stats[least].store(result, std::memory_order_release);
+    }
+
+    ~TranspositionTable() = default;
+private:
+    static constexpr size_t cn_TABLE_BUCKET = 4; // slots searched per position
+
+    size_t m_capacity;
+    std::unique_ptr<std::atomic<HashKey>[]>  m_keys;   // 0 marks an empty slot
+    std::unique_ptr<std::atomic<uint64_t>[]> m_stats;  // visits << 32 | wins
+
+    /// @brief getBucket : returns first slot of bucket for key.
+    size_t getBucket(const HashKey& key) const {
+        return static_cast<size_t>(key) & (m_capacity - 1) & ~(cn_TABLE_BUCKET - 1);
+    }
+};
+
+#endif
+    // TRANSPOSITION_TABLE_H
+
+/****************************************end of file****************************************/
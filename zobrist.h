@@ -0,0 +1,72 @@
+/**
+ * @name zobrist.h
+ * @brief provides Zobrist keys for hashing hex game positions.
+ */
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdint.h>
+
+#include "node.h"
+#include "adjacency.h"
+
+using HashKey = uint64_t;
+
+static const HashKey cn_ZOBRIST_SEED = 0x9E3779B97F4A7C15ull; // fixed, hashes are stable between runs
+
+/**
+ * @brief class Zobrist : one random key per (cell, colour), indexed by cell id.
+ * @tparam N - board size
+ *
+ * @details a position's hash is the XOR of the keys of every stone on the
+ * board, so placing or removing a stone updates the hash with a single XOR.
+ * Keys are generated at compile time with splitmix64.
+ */
+template <MapSize N>
+class Zobrist {
+public:
+    /// @brief get : returns constant key table for board size.
+    /// @return const Zobrist&
+    static const Zobrist& get() { return cn_TABLE; }
+
+    /// @brief getKey : returns key for stone of colour on cell.
+    /// @param colour - RED or GREEN
+    /// @param id
+    /// @return HashKey
+    constexpr HashKey getKey(const NodeColour& colour, const CellId& id) const {
+        return m_keys[id][(colour == NodeColour::RED) ? 0 : 1];
+    }
+
+    /// @brief Zobrist : constexpr constructor, generates keys.
+    constexpr Zobrist() :
+        m_keys{} {
+        HashKey state = cn_ZOBRIST_SEED + N;
+
+        for (CellId id = 0; id < Adjacency<N>::cn_CELL_COUNT; ++id) {
+            m_keys[id][0] = next(state);
+            m_keys[id][1] = next(state);
+        }
+    }
+
+    ~Zobrist() = default;
+private:
+    static const Zobrist cn_TABLE;
+
+    HashKey m_keys[Adjacency<N>::cn_CELL_COUNT][2]; // RED, GREEN
+
+    /// @brief next : splitmix64 step
+    static constexpr HashKey next(HashKey& state) {
+        HashKey z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+template <MapSize N>
+constexpr Zobrist<N> Zobrist<N>::cn_TABLE{};
+
+#endif
+    // ZOBRIST_H
+
+/****************************************end of file****************************************/